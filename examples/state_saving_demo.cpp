@@ -30,6 +30,8 @@ int main() {
 
     NavigationBuilder()
         .add_sections(all_sections)
+        // picks up where a crashed or disconnected session left off
+        .autosave("config.autosave")
         .on_exit([](const std::vector<Section> &sections) { save_state(sections); })
         .on_item_toggled([&all_sections](const size_t section_index, const size_t item_index, const bool selected) {
             if (section_index < all_sections.size() && item_index < all_sections[section_index].items.size()) {
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bitmap.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Boolean filter over item attributes and selection state
+     *
+     * Built with the helpers in tui::query and combined with &&, || and !:
+     *
+     * @code
+     * using namespace tui::query;
+     * section.filter(tag("arch") == "x86_64" && !selected);
+     * @endcode
+     *
+     * A default constructed query matches every item.
+     */
+    class Query {
+    public:
+        Query() = default;
+
+        static Query tag(std::string key, std::string value);
+        static Query has(std::string key); ///< Items with any value for key
+        static Query selected();
+
+        /**
+         * @brief Whether evaluating the query needs the selection state
+         */
+        [[nodiscard]] bool uses_selection() const { return node_ && node_->uses_selection; }
+
+        friend Query operator&&(Query a, Query b);
+        friend Query operator||(Query a, Query b);
+        friend Query operator!(Query query);
+
+    private:
+        friend class AttributeIndex;
+
+        enum class Kind { all, selected, tag, has, all_of, any_of, negate };
+
+        struct Node {
+            Kind kind = Kind::all;
+            std::string key;
+            std::string value;
+            std::vector<Query> children;
+            bool uses_selection = false;
+        };
+
+        explicit Query(Node node) : node_(std::make_shared<const Node>(std::move(node))) {}
+
+        [[nodiscard]] Kind kind() const { return node_ ? node_->kind : Kind::all; }
+        static Query combine(Kind kind, Query a, Query b);
+
+        std::shared_ptr<const Node> node_; ///< Shared, so copying a query is cheap
+    };
+
+    namespace query {
+        /**
+         * @brief Left-hand side of tag("key") == "value"
+         */
+        struct Tag {
+            std::string key;
+
+            Query operator==(std::string value) const { return Query::tag(key, std::move(value)); }
+            Query operator!=(std::string value) const { return !Query::tag(key, std::move(value)); }
+        };
+
+        inline Tag tag(std::string key) { return Tag{std::move(key)}; }
+        inline Query has(std::string key) { return Query::has(std::move(key)); }
+
+        inline const Query selected = Query::selected();
+    } // namespace query
+
+    /**
+     * @brief Key/value attributes of the items of one section, as bitmaps of item indices
+     *
+     * Every (key, value) pair owns a Bitmap of the items carrying it, so
+     * queries and facet counts are bitmap AND/OR/AND-NOT and popcounts rather
+     * than scans over items. An item has at most one value per key.
+     */
+    class AttributeIndex {
+    public:
+        struct Facet {
+            std::string_view value;
+            size_t count = 0;
+        };
+
+        /**
+         * @brief Give an item a value for key, replacing its previous one
+         *
+         * @return False if the item already had this value
+         */
+        bool set(uint32_t item, std::string_view key, std::string_view value);
+        bool erase(uint32_t item, std::string_view key);
+        void erase_item(uint32_t item);
+
+        [[nodiscard]] std::optional<std::string_view> get(uint32_t item, std::string_view key) const;
+
+        /**
+         * @brief Items carrying the pair, or nullptr if none does
+         */
+        [[nodiscard]] const Bitmap *items_with(std::string_view key, std::string_view value) const;
+
+        [[nodiscard]] std::vector<std::string_view> keys() const;
+        [[nodiscard]] bool empty() const { return values_.empty(); }
+        void clear() { values_.clear(); }
+
+        /**
+         * @brief Mirror a removal that moved item from into the freed index to
+         */
+        void relocate(uint32_t from, uint32_t to);
+
+        /**
+         * @brief Renumber items after storage was reordered; new index i held old_index[i]
+         */
+        void permute(std::span<const uint32_t> old_index);
+
+        /**
+         * @brief Items in [0, universe) matching query
+         *
+         * @param selected Selected items; only read if query.uses_selection()
+         */
+        [[nodiscard]] Bitmap evaluate(const Query &query, uint32_t universe, const Bitmap &selected) const;
+
+        /**
+         * @brief Number of items in within carrying each value of key, ordered by value
+         */
+        [[nodiscard]] std::vector<Facet> facet_counts(std::string_view key, const Bitmap &within) const;
+
+    private:
+        using Values = std::map<std::string, Bitmap, std::less<>>;
+
+        std::map<std::string, Values, std::less<>> values_; ///< key -> value -> items
+
+        void for_each_bitmap(const std::function<void(Bitmap &)> &fn);
+    };
+
+} // namespace tui
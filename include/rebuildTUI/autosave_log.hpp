@@ -0,0 +1,186 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "selection_events.hpp"
+#include "selection_snapshot.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Crash-safe record of selection changes: a snapshot plus an append-only log
+     *
+     * Each change is queued as a fixed-size record (section and item name
+     * hash, new state, checksum) and written to path + ".log" by a background
+     * thread. Records arriving while the thread syncs are written together, and
+     * fdatasync runs at most once per Options::sync_interval, so holding down
+     * space costs a few syncs, not one per item.
+     *
+     * Every Options::compact_after records the thread folds the log into the
+     * snapshot at path (see SnapshotWriter) and truncates the log. Folding
+     * works on the stored hashes alone, so sections that aren't loaded keep
+     * their state. Records replay as absolute states, which makes a crash
+     * between the snapshot rename and the truncation harmless.
+     *
+     * @code
+     * auto autosave = AutosaveLog::open("selection.autosave");
+     * for (auto &section : sections) {
+     *     autosave->restore(section);
+     * }
+     * // on every change batch
+     * autosave->append(section, section.end_batch());
+     * @endcode
+     */
+    class AutosaveLog {
+    public:
+        struct Options {
+            std::chrono::milliseconds sync_interval{100}; ///< Minimum time between two syncs
+            size_t compact_after = 4096;                  ///< Log records folded into the snapshot at a time
+        };
+
+        /**
+         * @brief Load the state saved at path and open its log for appending
+         *
+         * A torn record at the end of the log, left by a crash mid-write, is
+         * cut off together with everything after it.
+         *
+         * @return nullptr if the log can't be created or opened
+         */
+        static std::unique_ptr<AutosaveLog> open(const std::string &path, Options options);
+        static std::unique_ptr<AutosaveLog> open(const std::string &path) { return open(path, Options{}); }
+
+        /**
+         * @brief Write out and sync everything queued, fold the log and stop the thread
+         */
+        ~AutosaveLog();
+
+        AutosaveLog(const AutosaveLog &) = delete;
+        AutosaveLog &operator=(const AutosaveLog &) = delete;
+
+        /**
+         * @brief Apply the saved state to section as one batch, bypassing constraints
+         *
+         * The state is the one loaded by open() with everything append()ed
+         * since laid over it, so items that arrive after the first restore can
+         * be restored on their own.
+         *
+         * @param first Index of the first item to restore; earlier items are left alone
+         * @return Number of items that had a saved state
+         */
+        template <typename SectionT>
+        size_t restore(SectionT &section, const size_t first = 0) const {
+            const uint64_t section_hash = snapshot_hash(section.name);
+            auto stored = snapshot_ ? snapshot_->find(section.name) : std::nullopt;
+            const auto logged = latest_.find(section_hash);
+            if (first >= section.size() || (!stored && logged == latest_.end())) {
+                return 0;
+            }
+
+            size_t found = 0;
+            section.begin_batch();
+            for (size_t index = first; index < section.size(); ++index) {
+                const uint64_t hash = snapshot_hash(section.item_name(index));
+                std::optional<bool> selected;
+                if (logged != latest_.end()) {
+                    if (const auto it = logged->second.find(hash); it != logged->second.end()) {
+                        selected = it->second;
+                    }
+                }
+                if (!selected && stored) {
+                    selected = stored->lookup(index, hash);
+                }
+                if (selected) {
+                    section.restore_item_selected(index, *selected);
+                    ++found;
+                }
+            }
+            section.end_batch();
+            return found;
+        }
+
+        /**
+         * @brief True if a state was saved for the section with this name
+         */
+        [[nodiscard]] bool covers(std::string_view section_name) const;
+
+        /**
+         * @brief Queue a change batch of section; returns immediately
+         */
+        template <typename SectionT>
+        void append(const SectionT &section, const std::span<const ItemChange> changes) {
+            if (changes.empty()) {
+                return;
+            }
+            const uint64_t section_hash = snapshot_hash(section.name);
+            std::vector<Record> records;
+            records.reserve(changes.size());
+            auto &latest = latest_[section_hash];
+            for (const auto &[item_index, selected] : changes) {
+                records.push_back({section_hash, snapshot_hash(section.item_name(item_index)), selected});
+                latest[records.back().item_hash] = selected;
+            }
+            enqueue(std::move(records));
+        }
+
+        /**
+         * @brief Block until everything appended so far is synced
+         */
+        void flush();
+
+        /**
+         * @brief False once a write, sync or compaction failed; later changes are still attempted
+         */
+        [[nodiscard]] bool healthy() const;
+
+        [[nodiscard]] const std::string &path() const { return path_; }
+        [[nodiscard]] std::string log_path() const { return path_ + ".log"; }
+
+    private:
+        struct Record {
+            uint64_t section_hash;
+            uint64_t item_hash;
+            bool selected;
+        };
+
+        /// Latest logged state per section hash, then per item hash
+        using LoggedState = std::unordered_map<uint64_t, std::unordered_map<uint64_t, bool>>;
+
+        AutosaveLog(std::string path, Options options) : path_(std::move(path)), options_(options) {}
+
+        void enqueue(std::vector<Record> records);
+        void run(const std::stop_token &stop);
+        bool persist(const std::vector<Record> &records);
+        bool compact();
+
+        std::string path_;
+        Options options_;
+        int fd_ = -1;
+
+        // Loaded by open(); once the thread runs, logged_ belongs to it
+        std::unique_ptr<SnapshotReader> snapshot_; ///< Snapshot as opened; compaction renames a new one over it
+        LoggedState latest_;                       ///< Log as opened plus everything appended, for restore()
+        LoggedState logged_;                       ///< Logged since the last compaction
+        size_t logged_records_ = 0;
+
+        mutable std::mutex mutex_;
+        std::condition_variable_any wake_;
+        std::condition_variable_any synced_;
+        std::vector<Record> queue_;
+        uint64_t appended_ = 0;
+        uint64_t durable_ = 0;
+        bool flush_requested_ = false;
+        bool healthy_ = true;
+        std::jthread thread_; ///< Started by the first append(), last so it stops before the rest
+    };
+
+} // namespace tui
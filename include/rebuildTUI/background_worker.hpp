@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace tui {
+
+    /**
+     * @brief Single background thread running queued tasks in order
+     *
+     * Urgent tasks jump the queue, e.g. a fetch the user is waiting for ahead
+     * of speculative ones. Queued tasks are dropped on destruction; a task that
+     * is already running is waited for.
+     */
+    class BackgroundWorker {
+    public:
+        using Task = std::function<void()>;
+
+        BackgroundWorker() : thread_([this](const std::stop_token &stop) { run(stop); }) {}
+
+        ~BackgroundWorker() {
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.clear();
+                thread_.request_stop();
+            }
+            wake_.notify_all();
+        }
+
+        BackgroundWorker(const BackgroundWorker &) = delete;
+        BackgroundWorker &operator=(const BackgroundWorker &) = delete;
+
+        void post(Task task) {
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.push_back(std::move(task));
+            }
+            wake_.notify_one();
+        }
+
+        void post_urgent(Task task) {
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.push_front(std::move(task));
+            }
+            wake_.notify_one();
+        }
+
+        /**
+         * @brief Drop every task that hasn't started yet
+         */
+        void clear() {
+            std::lock_guard lock(mutex_);
+            tasks_.clear();
+        }
+
+        [[nodiscard]] size_t pending() const {
+            std::lock_guard lock(mutex_);
+            return tasks_.size();
+        }
+
+    private:
+        void run(const std::stop_token &stop) {
+            while (true) {
+                Task task;
+                {
+                    std::unique_lock lock(mutex_);
+                    // once stop is requested the wait returns with tasks still queued; drop them
+                    if (!wake_.wait(lock, stop, [this] { return !tasks_.empty(); }) || stop.stop_requested()) {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        mutable std::mutex mutex_;
+        std::condition_variable_any wake_;
+        std::deque<Task> tasks_;
+        std::jthread thread_; ///< Last, so it starts after and stops before the queue
+    };
+
+} // namespace tui
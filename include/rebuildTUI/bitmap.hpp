@@ -0,0 +1,107 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tui {
+
+    /**
+     * @brief Compressed set of 32-bit integers, in the style of roaring bitmaps
+     *
+     * Values are split by their high 16 bits into containers. A container holds
+     * its low 16 bits either as a sorted array, while it has at most
+     * max_array_size values, or as a 65536-bit bitset once it is denser. Sparse
+     * and dense sets both stay small, and set operations work a container at a
+     * time: merges for arrays, word-wise logic and popcount for bitsets.
+     */
+    class Bitmap {
+    public:
+        static constexpr size_t max_array_size = 4096;
+
+        Bitmap() = default;
+
+        /**
+         * @brief Bitmap holding every value in [first, last)
+         */
+        static Bitmap range(uint32_t first, uint32_t last);
+
+        bool add(uint32_t value);
+        bool remove(uint32_t value);
+        [[nodiscard]] bool contains(uint32_t value) const;
+
+        /**
+         * @brief Move membership of from to to, clearing to first
+         *
+         * Mirrors a container that moves its last element into a freed slot.
+         */
+        void relocate(uint32_t from, uint32_t to);
+
+        [[nodiscard]] size_t cardinality() const;
+        [[nodiscard]] bool empty() const { return containers_.empty(); }
+        void clear() { containers_.clear(); }
+
+        Bitmap &operator&=(const Bitmap &other);
+        Bitmap &operator|=(const Bitmap &other);
+        Bitmap &operator-=(const Bitmap &other); ///< Remove every value of other
+
+        friend Bitmap operator&(Bitmap a, const Bitmap &b) { return a &= b; }
+        friend Bitmap operator|(Bitmap a, const Bitmap &b) { return a |= b; }
+        friend Bitmap operator-(Bitmap a, const Bitmap &b) { return a -= b; }
+
+        /**
+         * @brief Size of the intersection, without building it
+         */
+        [[nodiscard]] static size_t and_cardinality(const Bitmap &a, const Bitmap &b);
+
+        /**
+         * @brief Call fn with every value, in ascending order
+         */
+        template <typename Fn>
+        void for_each(Fn &&fn) const {
+            for (const auto &container : containers_) {
+                const uint32_t high = static_cast<uint32_t>(container.key) << 16;
+                if (!container.is_bitset()) {
+                    for (const uint16_t low : container.values) {
+                        fn(high | low);
+                    }
+                    continue;
+                }
+                for (size_t word = 0; word < container.bits.size(); ++word) {
+                    for (uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1) {
+                        fn(high | static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] std::vector<uint32_t> to_vector() const;
+
+        bool operator==(const Bitmap &other) const;
+
+    private:
+        struct Container {
+            uint16_t key = 0;                ///< High 16 bits shared by the values
+            uint32_t cardinality = 0;
+            std::vector<uint16_t> values;    ///< Sorted low bits while sparse
+            std::vector<uint64_t> bits;      ///< 1024 words once dense, empty otherwise
+
+            [[nodiscard]] bool is_bitset() const { return !bits.empty(); }
+        };
+
+        std::vector<Container> containers_; ///< Sorted by key, never empty containers
+
+        Container *find(uint16_t key);
+        [[nodiscard]] const Container *find(uint16_t key) const;
+
+        static void to_bitset(Container &container);
+        static void to_array(Container &container);
+        static void normalize(Container &container);
+        static Container intersect(const Container &a, const Container &b);
+        static Container unite(const Container &a, const Container &b);
+        static Container subtract(const Container &a, const Container &b);
+        static size_t intersect_count(const Container &a, const Container &b);
+    };
+
+} // namespace tui
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "handle.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Requirements, conflicts and radio groups between the items of a section
+     *
+     * Built with ConstraintBuilder and attached with Section::set_constraints().
+     * Nodes are item handles, so the graph survives removal and sorting of
+     * other items; constraints on a removed item are ignored.
+     *
+     * - require(a, b): selecting a selects b, deselecting b deselects a
+     * - conflict(a, b): selecting either deselects the other
+     * - radio group: selecting a member deselects the others
+     */
+    class ConstraintGraph {
+    public:
+        using Assignment = std::pair<ItemHandle, bool>;
+
+        /**
+         * @brief Current selection of an item, or nullopt if it no longer exists
+         */
+        using StateFn = std::function<std::optional<bool>(ItemHandle)>;
+
+        ConstraintGraph() = default;
+
+        /**
+         * @brief Changes needed to set root to selected without breaking a constraint
+         *
+         * Walks outward from root only through items whose state actually has
+         * to change; items already in the required state end the walk, since
+         * their own constraints hold. The first entry is root itself.
+         *
+         * @return nullopt if the change would have to flip an item both ways,
+         * e.g. selecting an item that requires something it conflicts with
+         */
+        [[nodiscard]] std::optional<std::vector<Assignment>> propagate(ItemHandle root, bool selected,
+                                                                       const StateFn &state) const;
+
+        [[nodiscard]] size_t node_count() const { return nodes_.size(); }
+        [[nodiscard]] bool empty() const { return nodes_.empty(); }
+
+    private:
+        friend class ConstraintBuilder;
+
+        /**
+         * @brief Compressed adjacency lists, one span of targets per node
+         */
+        struct Adjacency {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> targets;
+
+            static Adjacency pack(size_t node_count, std::vector<std::pair<uint32_t, uint32_t>> edges);
+            [[nodiscard]] std::span<const uint32_t> operator[](uint32_t node) const;
+        };
+
+        std::vector<ItemHandle> nodes_;
+        std::unordered_map<uint32_t, uint32_t> node_of_slot_;
+        Adjacency requires_;
+        Adjacency required_by_;
+        Adjacency conflicts_;
+        Adjacency groups_of_;     ///< node -> radio groups it belongs to
+        Adjacency group_members_; ///< radio group -> nodes
+
+        [[nodiscard]] std::optional<uint32_t> node_of(ItemHandle item) const;
+    };
+
+    /**
+     * @brief Collects constraints by item name and checks them when building the graph
+     *
+     * @code
+     * ConstraintBuilder builder;
+     * builder.require("VPN Integration", "Secure DNS").radio_group({"Performance", "Balanced", "Power Saver"});
+     * auto graph = builder.build(section);
+     * if (!graph) {
+     *     std::println("{}", builder.problem());
+     * }
+     * @endcode
+     */
+    class ConstraintBuilder {
+    public:
+        using Resolver = std::function<ItemHandle(std::string_view)>;
+
+        ConstraintBuilder &require(std::string item, std::string dependency);
+        ConstraintBuilder &conflict(std::string a, std::string b);
+        ConstraintBuilder &radio_group(std::vector<std::string> members);
+
+        /**
+         * @brief Resolve names and build the graph
+         *
+         * Fails on unknown names, on requirement cycles and on items that
+         * require something they directly conflict with; problem() then says
+         * which.
+         */
+        std::optional<ConstraintGraph> build(const Resolver &resolve);
+
+        /**
+         * @brief Build against the owned items of a section, looked up by name
+         */
+        template <typename SectionT>
+            requires requires(const SectionT &section) { section.handle_of(size_t{}); }
+        std::optional<ConstraintGraph> build(const SectionT &section) {
+            std::unordered_map<std::string_view, size_t> index_of;
+            for (size_t index = 0; index < section.items.size(); ++index) {
+                index_of.emplace(section.items[index].name, index);
+            }
+            return build(Resolver([&](const std::string_view name) {
+                const auto it = index_of.find(name);
+                return it != index_of.end() ? section.handle_of(it->second) : ItemHandle{};
+            }));
+        }
+
+        /**
+         * @brief Why the last build() failed, empty after a successful one
+         */
+        [[nodiscard]] const std::string &problem() const { return problem_; }
+
+    private:
+        std::vector<std::pair<std::string, std::string>> requirements_;
+        std::vector<std::pair<std::string, std::string>> conflicts_;
+        std::vector<std::vector<std::string>> radio_groups_;
+        std::string problem_;
+    };
+
+} // namespace tui
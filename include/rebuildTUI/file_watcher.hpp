@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace tui {
+
+    /**
+     * @brief Calls back when watched files change, from a thread of its own
+     *
+     * On Linux the parent directory is watched with inotify, so a file that is
+     * replaced by a rename (how most editors and config tools save) keeps being
+     * followed. A burst of writes is reported once, after the file has been
+     * quiet for `settle`. Elsewhere modification times are polled instead.
+     */
+    class FileWatcher {
+    public:
+        using Callback = std::function<void(const std::string &path)>;
+
+        explicit FileWatcher(Callback on_change,
+                             std::chrono::milliseconds settle = std::chrono::milliseconds(200));
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        /**
+         * @brief Start reporting changes to path; the file need not exist yet
+         *
+         * @return False if its directory can't be watched
+         */
+        bool watch(const std::string &path);
+        void unwatch(const std::string &path);
+
+    private:
+        struct Watched {
+            std::filesystem::path directory;
+            std::string file_name;
+            int descriptor = -1;                        ///< inotify watch of the directory
+            std::filesystem::file_time_type written{}; ///< Polling fallback: last seen modification
+        };
+
+        void run(const std::stop_token &stop);
+        void collect_changes(std::chrono::steady_clock::time_point now);
+
+        Callback on_change_;
+        std::chrono::milliseconds settle_;
+        int inotify_fd_ = -1;
+
+        std::mutex mutex_;
+        std::map<std::string, Watched> watched_; ///< By the path given to watch()
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> pending_; ///< Path to report deadline
+
+        std::jthread thread_; ///< Last, so it starts after and stops before the rest
+    };
+
+} // namespace tui
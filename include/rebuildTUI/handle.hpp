@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace tui {
+
+    /**
+     * @brief Generational handle to an element of a slot table
+     *
+     * A handle stays valid across insertions and removals of other elements and
+     * becomes stale (never dangling) once its own element is removed.
+     */
+    template <typename Tag>
+    struct Handle {
+        static constexpr uint32_t invalid_slot = std::numeric_limits<uint32_t>::max();
+
+        uint32_t slot = invalid_slot; ///< Index into the slot table
+        uint32_t generation = 0;      ///< Generation the slot had when the handle was issued
+
+        [[nodiscard]] bool valid() const { return slot != invalid_slot; }
+
+        bool operator==(const Handle &) const = default;
+    };
+
+    struct SectionTag;
+    struct ItemTag;
+
+    using SectionHandle = Handle<SectionTag>;
+    using ItemHandle = Handle<ItemTag>;
+
+    /**
+     * @brief Maps generational handles to indices in a dense storage vector
+     *
+     * Owners keep their elements densely packed (removal moves the last element
+     * into the hole) and report moves via relocate(), so lookups stay O(1).
+     */
+    template <typename Tag>
+    class SlotTable {
+    public:
+        using handle_type = Handle<Tag>;
+
+        handle_type acquire(const size_t dense_index) {
+            uint32_t slot;
+            if (!free_slots_.empty()) {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+                slots_[slot].dense_index = static_cast<uint32_t>(dense_index);
+            } else {
+                slot = static_cast<uint32_t>(slots_.size());
+                slots_.push_back({static_cast<uint32_t>(dense_index), 0});
+            }
+            return {slot, slots_[slot].generation};
+        }
+
+        void release(const handle_type handle) {
+            if (contains(handle)) {
+                ++slots_[handle.slot].generation;
+                slots_[handle.slot].dense_index = free_index;
+                free_slots_.push_back(handle.slot);
+            }
+        }
+
+        void relocate(const handle_type handle, const size_t dense_index) {
+            if (contains(handle)) {
+                slots_[handle.slot].dense_index = static_cast<uint32_t>(dense_index);
+            }
+        }
+
+        [[nodiscard]] bool contains(const handle_type handle) const {
+            return handle.slot < slots_.size() && slots_[handle.slot].generation == handle.generation &&
+                slots_[handle.slot].dense_index != free_index;
+        }
+
+        [[nodiscard]] std::optional<size_t> find(const handle_type handle) const {
+            if (!contains(handle)) {
+                return std::nullopt;
+            }
+            return slots_[handle.slot].dense_index;
+        }
+
+    private:
+        static constexpr uint32_t free_index = std::numeric_limits<uint32_t>::max();
+
+        struct Slot {
+            uint32_t dense_index;
+            uint32_t generation;
+        };
+
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> free_slots_;
+    };
+
+} // namespace tui
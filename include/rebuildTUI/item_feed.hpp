@@ -0,0 +1,104 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "handle.hpp"
+#include "selectable_item.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Thread-safe queue of item batches for sections that are filled in the background
+     *
+     * Producers push from any thread; NavigationTUI drains the queue on its own
+     * thread between frames and appends the items to the target sections, so
+     * sections are never touched concurrently.
+     */
+    class ItemFeed {
+    public:
+        struct Batch {
+            SectionHandle section;
+            std::vector<SelectableItem> items;
+            bool done = false; ///< Producer finished, no more batches for this section
+        };
+
+        void push(const SectionHandle section, std::vector<SelectableItem> items) {
+            if (items.empty()) {
+                return;
+            }
+            std::lock_guard lock(mutex_);
+            pending_.push_back({section, std::move(items)});
+        }
+
+        /**
+         * @brief Mark a section as complete, after all of its batches
+         */
+        void close(const SectionHandle section) {
+            std::lock_guard lock(mutex_);
+            pending_.push_back({section, {}, true});
+        }
+
+        /**
+         * @brief Take everything pushed so far, in push order
+         */
+        std::vector<Batch> drain() {
+            std::lock_guard lock(mutex_);
+            return std::exchange(pending_, {});
+        }
+
+        [[nodiscard]] bool empty() const {
+            std::lock_guard lock(mutex_);
+            return pending_.empty();
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<Batch> pending_;
+    };
+
+    /**
+     * @brief Handed to an async section provider to deliver its items
+     *
+     * Providers run on their own thread and may push any number of batches;
+     * they should return early once stop_requested() turns true.
+     */
+    class ItemSink {
+    public:
+        ItemSink(std::shared_ptr<ItemFeed> feed, const SectionHandle section, std::stop_token stop) :
+            feed_(std::move(feed)), section_(section), stop_(std::move(stop)) {}
+
+        void push(std::vector<SelectableItem> items) const { feed_->push(section_, std::move(items)); }
+        void push(SelectableItem item) const { feed_->push(section_, {std::move(item)}); }
+
+        [[nodiscard]] bool stop_requested() const { return stop_.stop_requested(); }
+
+    private:
+        std::shared_ptr<ItemFeed> feed_;
+        SectionHandle section_;
+        std::stop_token stop_;
+    };
+
+    using SectionProvider = std::function<void(ItemSink &sink)>;
+
+    /**
+     * @brief Run a provider on a background thread and close the section when it returns
+     *
+     * Exceptions thrown by the provider end the section as well; items pushed
+     * until then are kept.
+     */
+    std::jthread run_provider(SectionProvider provider, std::shared_ptr<ItemFeed> feed, SectionHandle section);
+
+    /**
+     * @brief Read newline-delimited items from a descriptor on a background thread
+     *
+     * Each line becomes one item (`name` or `name<TAB>description`, like
+     * MappedFileSource); lines are pushed to the feed once per read chunk. The
+     * section is closed at end of file; the thread also stops when stop is requested.
+     */
+    std::jthread stream_lines(int fd, std::shared_ptr<ItemFeed> feed, SectionHandle section);
+
+} // namespace tui
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "selectable_item.hpp"
+
+namespace tui {
+
+    enum class ItemFileFormat {
+        lines, ///< `name` or `name<TAB>description` per line, blank lines skipped
+        ini,   ///< `name = value` lines under `[Section]` headers; true/yes/on/1 marks an item selected
+        json,  ///< Array of names, or of objects with "name" and optional "description", "id", "selected"
+    };
+
+    /**
+     * @brief Items described by the contents of a file
+     *
+     * @param section_name For INI, the block to read; ignored otherwise
+     * @return nullopt if the contents don't parse, e.g. a file caught half
+     *         written, or the INI block is missing
+     */
+    std::optional<std::vector<SelectableItem>> parse_items(std::string_view contents, ItemFileFormat format,
+                                                           std::string_view section_name = {});
+
+    /**
+     * @brief parse_items() on a file; nullopt if it can't be read either
+     */
+    std::optional<std::vector<SelectableItem>> load_items(const std::string &path, ItemFileFormat format,
+                                                          std::string_view section_name = {});
+
+} // namespace tui
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tui {
+
+    /**
+     * @brief Read-only provider of item names and descriptions
+     *
+     * A section backed by a source does not own its items: rows are read on
+     * demand and only the selection state is stored in the section. The views
+     * returned must stay valid at least until the source is asked for another
+     * row.
+     *
+     * Slow sources can override the hooks below so the renderer never waits
+     * for them: rows that aren't ready are drawn as placeholders and repainted
+     * once revision() changes.
+     */
+    class ItemSource {
+    public:
+        virtual ~ItemSource() = default;
+
+        [[nodiscard]] virtual size_t size() const = 0;
+        [[nodiscard]] virtual std::string_view name(size_t index) const = 0;
+        [[nodiscard]] virtual std::string_view description(size_t index) const = 0;
+
+        /**
+         * @brief Whether name()/description() of index can be answered without blocking
+         */
+        [[nodiscard]] virtual bool is_ready(size_t /*index*/) const { return true; }
+
+        /**
+         * @brief Rows [first, last) are on screen now
+         */
+        virtual void on_view(size_t /*first*/, size_t /*last*/) const {}
+
+        /**
+         * @brief Bumped whenever rows became ready in the background
+         */
+        [[nodiscard]] virtual uint64_t revision() const { return 0; }
+
+        /**
+         * @brief Whether rows may be read from several threads at once
+         *
+         * True promises that name() and description() can be called
+         * concurrently and that their views live as long as the source. Other
+         * sources are only read from the thread that asks: bulk queries scan
+         * them there, and the search index copies their names first.
+         */
+        [[nodiscard]] virtual bool concurrent_reads() const { return false; }
+    };
+
+} // namespace tui
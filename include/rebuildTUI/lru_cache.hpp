@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace tui {
+
+    /**
+     * @brief Fixed-capacity map that evicts the least recently used entry
+     *
+     * Not synchronized; owners that share it between threads lock around it.
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache {
+    public:
+        struct Stats {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+        };
+
+        explicit LruCache(const size_t capacity) : capacity_(capacity) {}
+
+        /**
+         * @brief Look up a value and mark it as most recently used
+         *
+         * @return nullptr on a miss
+         */
+        Value *find(const Key &key) {
+            const auto it = index_.find(key);
+            if (it == index_.end()) {
+                ++stats_.misses;
+                return nullptr;
+            }
+            ++stats_.hits;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return &it->second->second;
+        }
+
+        /**
+         * @brief Presence check that neither touches the entry nor counts as a lookup
+         */
+        [[nodiscard]] bool contains(const Key &key) const { return index_.contains(key); }
+
+        void put(const Key &key, Value value) {
+            if (const auto it = index_.find(key); it != index_.end()) {
+                it->second->second = std::move(value);
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return;
+            }
+
+            entries_.emplace_front(key, std::move(value));
+            index_.emplace(key, entries_.begin());
+            trim();
+        }
+
+        bool erase(const Key &key) {
+            const auto it = index_.find(key);
+            if (it == index_.end()) {
+                return false;
+            }
+            entries_.erase(it->second);
+            index_.erase(it);
+            return true;
+        }
+
+        void set_capacity(const size_t capacity) {
+            capacity_ = capacity;
+            trim();
+        }
+
+        void clear() {
+            entries_.clear();
+            index_.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return entries_.size(); }
+        [[nodiscard]] size_t capacity() const { return capacity_; }
+        [[nodiscard]] const Stats &stats() const { return stats_; }
+
+    private:
+        using Entries = std::list<std::pair<Key, Value>>;
+
+        void trim() {
+            while (entries_.size() > capacity_) {
+                index_.erase(entries_.back().first);
+                entries_.pop_back();
+                ++stats_.evictions;
+            }
+        }
+
+        size_t capacity_;
+        Entries entries_; ///< Most recently used first
+        std::unordered_map<Key, typename Entries::iterator, Hash> index_;
+        Stats stats_;
+    };
+
+} // namespace tui
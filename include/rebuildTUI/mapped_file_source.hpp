@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "item_source.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Item source over a memory-mapped, newline-delimited text file
+     *
+     * Every line is one item, either `name` or `name<TAB>description`; CRLF line
+     * endings are accepted. Opening only maps the file and records where each
+     * line starts, so names and descriptions are views into the mapping and no
+     * per-item allocation happens.
+     *
+     * The file must not be truncated while it is mapped; to pick up changes,
+     * open it again and reconcile.
+     */
+    class MappedFileSource final : public ItemSource {
+    public:
+        /**
+         * @brief Map a file and index its lines
+         *
+         * @return nullptr if the file can't be opened or mapped
+         */
+        static std::shared_ptr<MappedFileSource> open(const std::string &path);
+
+        ~MappedFileSource() override;
+
+        MappedFileSource(const MappedFileSource &) = delete;
+        MappedFileSource &operator=(const MappedFileSource &) = delete;
+
+        [[nodiscard]] size_t size() const override { return line_starts_.size(); }
+        [[nodiscard]] std::string_view name(size_t index) const override;
+        [[nodiscard]] std::string_view description(size_t index) const override;
+        [[nodiscard]] bool concurrent_reads() const override { return true; }
+
+        /**
+         * @brief Whole line without the line terminator
+         */
+        [[nodiscard]] std::string_view line(size_t index) const;
+
+        [[nodiscard]] const std::string &path() const { return path_; }
+        [[nodiscard]] size_t size_bytes() const { return length_; }
+
+    private:
+        MappedFileSource() = default;
+
+        void index_lines();
+
+        std::string path_;
+        const char *data_ = nullptr;
+        size_t length_ = 0;
+        std::vector<size_t> line_starts_; ///< Offset of the first byte of every line
+#ifdef _WIN32
+        std::vector<char> buffer_; ///< No mmap here, the file is read into memory instead
+#endif
+    };
+
+} // namespace tui
@@ -1,25 +1,62 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
+#include "autosave_log.hpp"
+#include "background_worker.hpp"
+#include "file_watcher.hpp"
+#include "handle.hpp"
+#include "item_feed.hpp"
+#include "item_parsers.hpp"
+#include "lru_cache.hpp"
 #include "section.hpp"
+#include "selection_events.hpp"
+#include "selection_export.hpp"
+#include "selection_journal.hpp"
+#include "selection_snapshot.hpp"
 #include "styles.hpp"
 #include "terminal_utils.hpp"
+#include "trigram_index.hpp"
 
 namespace tui {
     /**
      * @brief TUI interface prototype
+     *
+     * Sections are stored as SectionT, so typed payloads stay inline in the
+     * items: callbacks, loaders and predicates see the same section type.
+     * NavigationTUI and PlainNavigationTUI are compiled into the library; other
+     * section types are instantiated from navigation_tui_impl.hpp.
+     *
+     * @tparam SectionT Section type held by the TUI, a BasicSection
      */
-    class NavigationTUI {
+    template <typename SectionT = Section>
+    class BasicNavigationTUI {
     public:
+        using section_type = SectionT;
+        using item_type = typename SectionT::item_type;
+
         enum class NavigationState {
             MAIN_MENU,     ///< User is selecting a section (Main menu)
             ITEM_SELECTION ///< User is selecting/managing items within a section
         };
 
+        enum class RunMode {
+            automatic,   ///< Headless unless TerminalUtils::has_terminal()
+            interactive, ///< Always set up the terminal and read keys
+            headless,    ///< Apply the configured selections and exit, no terminal involved
+        };
+
         /**
          * @brief Display theme configuration
          */
@@ -64,10 +101,17 @@ namespace tui {
             std::string section_selection_title = "Select Section";
             std::string item_selection_prefix = "Section: ";
             std::string empty_section_message = "No items in this section.";
+            std::string loading_message = "Loading";
+            std::string search_title = "Jump to item";
+            std::string search_help = "Type to search | Up/Down - choose | Enter - jump | Esc - cancel";
+            std::string search_no_results = "No matching items.";
+            std::string goto_prompt = "Go to (N or pN): ";
             std::string help_text_sections = "Enter - select | q - quit | 1-9 - quick select";
             std::string help_text_items =
                 "Space - toggle | Enter - select | b/Esc - back | "
-                "1-9 - page";
+                "1-9 - page | u/r - undo/redo";
+            std::string help_text_type_ahead = ///< Item help while type-ahead takes the lowercase letters
+                "Type to jump | Space - toggle | B/Esc - back | A/N - all/none | U/R - undo/redo | Q - quit";
             bool show_help_text = true;    ///< Whether to show help text
             bool show_page_numbers = true; ///< Whether to show page navigation info
             bool show_counters = true;     ///< Whether to show selection counters
@@ -85,20 +129,53 @@ namespace tui {
             std::map<char, std::string> custom_shortcuts; ///< Custom keyboard shortcuts
             bool enable_quick_select = true;              ///< Enable number keys for quick selection
             bool enable_vim_keys = false;                 ///< Enable vim-style navigation (hjkl)
+            bool enable_type_ahead = false; ///< Letters typed in quick succession jump to the first matching item
+
+            size_t lazy_memory_budget = 0; ///< Bytes lazy sections may keep loaded, 0 = no limit
+            size_t description_cache_entries = 256; ///< Provider descriptions kept, see set_description_provider()
+            size_t undo_history = 100;              ///< Selection batches undo() can step back through
+            std::string autosave_path; ///< Enable autosave here when run() starts, empty = off; see enable_autosave()
+
+            RunMode run_mode = RunMode::automatic;
+            std::chrono::milliseconds headless_load_timeout{30000}; ///< Headless wait for async sections, 0 = no limit
+            std::string selection_script;                ///< File of selection commands run() applies first
+            std::vector<std::string> selection_commands; ///< Applied by run() after the script
         };
 
         /**
          * @brief Event callback types
          */
-        using SectionSelectedCallback = std::function<void(size_t section_index, const Section &section)>;
+        using SectionSelectedCallback = std::function<void(size_t section_index, const section_type &section)>;
         using ItemToggledCallback = std::function<void(size_t section_index, size_t item_index, bool selected)>;
         using PageChangedCallback = std::function<void(int new_page, int total_pages)>;
         using StateChangedCallback = std::function<void(NavigationState old_state, NavigationState new_state)>;
-        using ExitCallback = std::function<void(const std::vector<Section> &sections)>;
+        using ExitCallback = std::function<void(const std::vector<section_type> &sections)>;
         using CustomCommandCallback = std::function<bool(char key, NavigationState state)>;
+        using SectionLoader = std::function<std::vector<item_type>(const section_type &section)>;
+        using ItemPredicate = std::function<bool(const section_type &section, size_t item_index)>;
+        using DescriptionProvider =
+            std::function<std::string(const std::string &section_name, const std::string &item_name)>;
+
+        /**
+         * @brief Location of an item: display index of its section, storage index inside it
+         */
+        struct ItemRef {
+            size_t section_index;
+            size_t item_index;
+
+            bool operator==(const ItemRef &) const = default;
+        };
 
     private:
-        std::vector<Section> sections_;
+        // Sections are stored densely; removal moves the last one into the hole,
+        // so display order lives in section_order_ (empty while it matches storage).
+        // Removal only marks the display position; the next lookup compacts.
+        std::vector<section_type> sections_;
+        std::vector<SectionHandle> section_handles_;
+        mutable std::vector<uint32_t> section_order_;     ///< Display index -> storage index
+        mutable std::vector<uint32_t> section_positions_; ///< Storage index -> display index, alongside section_order_
+        mutable size_t removed_section_positions_ = 0;    ///< Entries of section_order_ marked by removals
+        SlotTable<SectionTag> section_slots_;
         NavigationState current_state_;
         size_t current_section_index_;
         size_t current_selection_index_;
@@ -108,13 +185,28 @@ namespace tui {
         bool running_;
         bool needs_redraw_;
 
+        // Rows (display positions) to repaint when no full redraw is pending
+        struct RowLayout {
+            int first_row = 0;
+            int left_padding = 0;
+            int content_width = 0;
+        };
+        std::vector<size_t> dirty_rows_;
+        RowLayout row_layout_;
+
         // previous terminal size
         int previous_width_;
         int previous_height_;
 
         // Event callbacks
         SectionSelectedCallback on_section_selected_;
-        ItemToggledCallback on_item_toggled_;
+        SelectionEventBus selection_events_;
+        SubscriptionId item_toggled_subscription_ = 0;
+        SelectionJournal journal_;
+        bool replaying_journal_ = false;
+        std::unique_ptr<AutosaveLog> autosave_;
+        bool restoring_autosave_ = false; ///< Restored states are saved already, so they aren't logged again
+        std::string command_problem_;
         PageChangedCallback on_page_changed_;
         StateChangedCallback on_state_changed_;
         ExitCallback on_exit_;
@@ -123,39 +215,252 @@ namespace tui {
         // Terminal management
         std::unique_ptr<TerminalManager> terminal_manager_;
 
+        // Background producers, drained between frames
+        std::shared_ptr<ItemFeed> item_feed_ = std::make_shared<ItemFeed>();
+        std::chrono::steady_clock::time_point last_feed_drain_{};
+        std::vector<SectionHandle> loading_sections_; ///< Sections whose producer is still running
+        std::chrono::steady_clock::time_point last_spinner_tick_{};
+        size_t spinner_frame_ = 0;
+        std::vector<std::jthread> producers_;
+
+        // Sections loaded on enter and unloaded again under memory pressure
+        struct LazySection {
+            SectionHandle handle;
+            SectionLoader loader;
+            bool resident = false;
+            uint64_t last_used = 0;
+            size_t bytes = 0;                ///< Estimated size of the loaded items
+            size_t item_count = 0;                 ///< Item count when last unloaded
+            size_t selected_count = 0;             ///< Selected count when last unloaded
+            std::vector<uint64_t> selected_hashes; ///< Sorted name hashes of the selected items, while unloaded
+            uint64_t names_hash = 0;               ///< Hash of all item names in storage order when unloaded
+            uint64_t index_revision = 0;           ///< Section index revision when unloaded
+        };
+        std::vector<LazySection> lazy_sections_;
+        uint64_t lazy_clock_ = 0;
+
+        // Sections kept in sync with a file; reloads are parsed on the watcher thread, applied between frames
+        struct WatchedFile {
+            SectionHandle handle;
+            std::string path;
+            ItemFileFormat format;
+            std::string section_name; ///< INI block to read
+        };
+        struct FileReload {
+            SectionHandle handle;
+            std::vector<SelectableItem> items;
+        };
+        std::mutex reload_mutex_;
+        std::vector<WatchedFile> watched_files_;
+        std::vector<FileReload> file_reloads_; ///< Latest unapplied reload per section
+        std::unique_ptr<FileWatcher> file_watcher_; ///< Last, so it stops before the queue goes away
+
+        // Centered, unhighlighted rows of the shown page and its neighbours, built while idle
+        struct PrerenderedPage {
+            NavigationState state;
+            SectionHandle section; ///< Section of an item page, invalid for section pages
+            int page;
+            int content_width;
+            std::vector<SectionHandle> row_sections; ///< Section each row was built from
+            std::vector<uint64_t> row_revisions;     ///< Its Section::revision() at that time
+            std::vector<std::string> rows;
+        };
+        static constexpr size_t max_prerendered_pages = 8;
+        std::vector<PrerenderedPage> page_cache_;
+
+        // Rows of a slow item source shown as placeholders, repainted once the source catches up
+        bool awaiting_rows_ = false;
+        bool awaiting_footer_ = false;
+        uint64_t awaiting_revision_ = 0;
+
+        // Descriptions produced when an item is highlighted, on a worker thread
+        DescriptionProvider description_provider_;
+        std::mutex description_mutex_;
+        LruCache<std::string, std::string> description_cache_{0};
+        std::unordered_set<std::string> descriptions_in_flight_;
+        std::atomic<bool> description_arrived_{false};
+        bool awaiting_description_ = false;
+        std::unique_ptr<BackgroundWorker> description_worker_; ///< Last, so it stops before the cache goes away
+
+        // Global jump-to-item prompt ('/'), backed by an index kept up to date while idle
+        static constexpr size_t max_search_hits = 100;
+        TrigramIndex search_index_;
+        std::chrono::steady_clock::time_point last_index_sync_{};
+        bool search_active_ = false;
+        std::string search_query_;
+        std::vector<ItemRef> search_hits_;
+        size_t search_cursor_ = 0;
+
+        // Type-ahead: storage indices sorted by case-folded name, for recently used sections.
+        // Indices rather than display positions, since a grouped view moves items on every toggle
+        struct PrefixIndex {
+            SectionHandle section;
+            uint64_t revision; ///< Section::content_revision() it was built at
+            std::vector<uint32_t> indices;
+        };
+        static constexpr size_t max_prefix_indexes = 4;
+        static constexpr auto type_ahead_timeout = std::chrono::milliseconds(1000);
+        std::vector<PrefixIndex> prefix_indexes_;
+        std::string type_ahead_prefix_;
+        std::chrono::steady_clock::time_point last_type_ahead_{};
+
+        // Numeric jumps: digits typed in quick succession, or a ':' goto prompt
+        std::string number_buffer_;
+        std::chrono::steady_clock::time_point last_digit_{};
+        bool goto_active_ = false;
+        std::string goto_query_;
+
     public:
-        NavigationTUI();
-        explicit NavigationTUI(Config config);
-        ~NavigationTUI() = default;
+        BasicNavigationTUI();
+        explicit BasicNavigationTUI(Config config);
+        ~BasicNavigationTUI() = default;
 
-        NavigationTUI(const NavigationTUI &) = delete;
-        NavigationTUI &operator=(const NavigationTUI &) = delete;
+        BasicNavigationTUI(const BasicNavigationTUI &) = delete;
+        BasicNavigationTUI &operator=(const BasicNavigationTUI &) = delete;
 
-        NavigationTUI(NavigationTUI &&) = default;
-        NavigationTUI &operator=(NavigationTUI &&) = default;
+        // Worker, watcher and feed threads hold `this`, so the object stays where it was built;
+        // keep it behind the std::unique_ptr that BasicNavigationBuilder::build() returns
+        BasicNavigationTUI(BasicNavigationTUI &&) = delete;
+        BasicNavigationTUI &operator=(BasicNavigationTUI &&) = delete;
 
         /*
          * Section management
          */
-        void add_section(const Section &section);
-        void add_section(Section &&section);
-        void add_sections(const std::vector<Section> &sections);
-        void add_sections(std::vector<Section> &&sections);
+        void add_section(const section_type &section);
+        void add_section(section_type &&section);
+        void add_sections(const std::vector<section_type> &sections);
+        void add_sections(std::vector<section_type> &&sections);
 
         [[nodiscard]] size_t get_current_section_index() const;
-        Section *get_section(size_t index);
-        [[nodiscard]] const Section *get_section(size_t index) const;
+        section_type *get_section(size_t index);
+        [[nodiscard]] const section_type *get_section(size_t index) const;
 
-        Section *get_section_by_name(const std::string &name);
-        [[nodiscard]] const Section *get_section_by_name(const std::string &name) const;
+        section_type *get_section_by_name(const std::string &name);
+        [[nodiscard]] const section_type *get_section_by_name(const std::string &name) const;
 
         [[nodiscard]] size_t get_section_count() const;
 
+        /**
+         * @brief Generational handles that survive removal of other sections
+         *
+         * Unlike Section pointers, a handle never dangles: once its section is
+         * removed it simply stops resolving.
+         */
+        [[nodiscard]] SectionHandle get_section_handle(size_t index) const;
+        section_type *get_section(SectionHandle handle);
+        [[nodiscard]] const section_type *get_section(SectionHandle handle) const;
+        [[nodiscard]] std::optional<size_t> get_section_index(SectionHandle handle) const;
+
         bool remove_section(size_t index);
+        bool remove_section(SectionHandle handle);
         bool remove_section_by_name(const std::string &name);
 
         void clear_sections();
 
+        /**
+         * @brief Update the sections in place from freshly loaded data
+         *
+         * Sections are matched by name and their items by id (or name when the id
+         * is 0), see Section::reconcile(). Selections, observers, handles and the
+         * cursor survive; only rows that changed are repainted when the layout
+         * stays the same. Call it from the UI thread, e.g. from a callback.
+         *
+         * @return True if anything changed
+         */
+        bool reconcile(std::vector<section_type> &&sections);
+
+        /**
+         * @brief reconcile() for a single section, leaving the others alone
+         *
+         * @return True if anything changed; false as well if the handle is stale
+         */
+        bool reconcile_section(SectionHandle handle, section_type &&fresh);
+
+        /**
+         * @brief Keep a section's items in sync with a file while the TUI runs
+         *
+         * The file is loaded right away, then reloaded whenever it is written or
+         * replaced. Parsing happens on the watcher thread; the result is applied
+         * between frames with reconcile_section(), so selections survive and only
+         * changed rows are repainted. A reload that doesn't parse, e.g. a file
+         * caught half written, is skipped. INI files are read from the block named
+         * after the section. The file is always read into memory, never mapped,
+         * so a section backed by an ItemSource gets owned items from the first load.
+         *
+         * @return False if the file can't be loaded or watched, or the section is lazy
+         */
+        bool watch_section_file(SectionHandle handle, const std::string &path, ItemFileFormat format);
+        void unwatch_section_file(SectionHandle handle);
+
+        /**
+         * @brief Feed for filling sections from other threads
+         *
+         * Pushed batches are appended on the UI thread every few frames, so
+         * counters and pages update while the TUI is running.
+         */
+        [[nodiscard]] std::shared_ptr<ItemFeed> get_item_feed() const;
+
+        /**
+         * @brief Append lines read from fd (stdin by default) to a section in the background
+         *
+         * The TUI is usable right away; when stdin carries data, keystrokes are
+         * read from /dev/tty instead. The reader stops when the TUI is destroyed.
+         */
+        bool stream_section(size_t section_index, int fd = 0);
+
+        /**
+         * @brief Add a section whose items are produced in the background
+         *
+         * The section shows up right away with a spinner and fills in as the
+         * provider pushes batches, so the first frame doesn't wait for slow
+         * probes. Items already in `section` are kept.
+         *
+         * @return Handle of the new section
+         */
+        SectionHandle add_async_section(section_type section, SectionProvider provider);
+        SectionHandle add_async_section(section_type section, std::future<std::vector<item_type>> items);
+
+        /**
+         * @brief Whether a background producer is still filling the section
+         */
+        [[nodiscard]] bool is_section_loading(size_t section_index) const;
+
+        /**
+         * @brief Add a section whose items are only materialized when it is entered
+         *
+         * Unlike Section::on_enter, the loader supplies the items. Lazy sections
+         * that weren't visited recently are unloaded again once
+         * Config::lazy_memory_budget is exceeded; their selections are kept as
+         * item name hashes and restored by name on the next load, so items
+         * sharing a name share their state. If the loader returns the same
+         * names in the same order, undo steps stay valid. Item handles don't
+         * survive unloading, so sections with attributes or constraints (both
+         * refer to items by index or handle) are never unloaded.
+         *
+         * @return Handle of the new section
+         */
+        SectionHandle add_lazy_section(section_type section, SectionLoader loader);
+
+        /**
+         * @brief False for a lazy section whose items are not loaded right now
+         */
+        [[nodiscard]] bool is_section_resident(size_t section_index) const;
+
+        /**
+         * @brief Estimated bytes held by loaded lazy sections
+         */
+        [[nodiscard]] size_t get_resident_lazy_bytes() const;
+
+        /**
+         * @brief Produce descriptions on demand instead of storing them in every item
+         *
+         * The provider runs on a background thread when an item without a stored
+         * description is highlighted; the footer shows TextConfig::loading_message
+         * until it returns. The last Config::description_cache_entries results
+         * are kept. Passing nullptr switches back to stored descriptions only.
+         */
+        void set_description_provider(DescriptionProvider provider);
+
         /**
          * @brief Get all selections across all sections
          */
@@ -166,6 +471,16 @@ namespace tui {
          */
         [[nodiscard]] std::vector<std::string> get_section_selections(size_t section_index) const;
 
+        /**
+         * @brief Stream every selected item to fd, section by section in display order
+         *
+         * Unlike get_all_selections() nothing is collected first; see
+         * SelectionExporter for the formats.
+         *
+         * @return false if writing to fd failed
+         */
+        bool export_selections(int fd, ExportFormat format = ExportFormat::lines) const;
+
         /**
          * @brief Clear all selections across all sections
          */
@@ -176,6 +491,111 @@ namespace tui {
          */
         void clear_section_selections(size_t section_index);
 
+        /**
+         * @brief Bulk queries over every item of every section, evaluated on ThreadPool::shared()
+         *
+         * The predicate is called concurrently and must only read the section.
+         * Every section is prepared with Section::prepare_reads() first, so any
+         * const accessor is safe to call, index_at(), handle_of(), filter() and
+         * for_each_selected() included. Sections backed by a source without
+         * ItemSource::concurrent_reads() are scanned on the calling thread
+         * instead. Unloaded lazy sections are skipped. select_where() publishes one change batch per
+         * section and returns how many items actually changed.
+         */
+        size_t select_where(const ItemPredicate &predicate, bool selected = true);
+        [[nodiscard]] size_t count_where(const ItemPredicate &predicate) const;
+        [[nodiscard]] std::vector<ItemRef> collect_where(const ItemPredicate &predicate) const;
+
+        /**
+         * @brief Items of any section whose name contains query, ignoring case
+         *
+         * Served from a trigram index that is built in the background as
+         * sections are added and refreshed while the UI is idle, so items
+         * added moments ago may be missing. Queries need at least
+         * TrigramIndex::min_query_length characters. This is what the '/'
+         * prompt uses.
+         */
+        [[nodiscard]] std::vector<ItemRef> search_items(std::string_view query, size_t limit = 100) const;
+        [[nodiscard]] bool is_search_indexing() const { return search_index_.building(); }
+
+        /**
+         * @brief Enter the item's section with the cursor on the item
+         */
+        bool jump_to_item(const ItemRef &item);
+
+        /**
+         * @brief Step back or forward through selection changes ('u' and 'r')
+         *
+         * Every change batch published through this NavigationTUI is journaled
+         * as its net delta, compactly encoded (see IndexSet), up to
+         * Config::undo_history batches. Undo and redo are published as one
+         * batch again. Steps for sections whose items were added or removed
+         * since are dropped. Returns false if there was nothing to apply.
+         */
+        bool undo();
+        bool redo();
+        [[nodiscard]] bool can_undo() const { return journal_.can_undo(); }
+        [[nodiscard]] bool can_redo() const { return journal_.can_redo(); }
+        void clear_undo_history() { journal_.clear(); }
+        [[nodiscard]] const SelectionJournal &selection_journal() const { return journal_; }
+
+        /**
+         * @brief Save or restore the selection state of every section as a binary snapshot
+         *
+         * Sections and items are matched by name hash (see SnapshotWriter for
+         * the layout); items not in the snapshot keep their state. A restore
+         * publishes one batch per section and can be undone.
+         *
+         * @return restore_snapshot(): items found in the snapshot, or nullopt if it can't be read
+         */
+        [[nodiscard]] bool save_snapshot(const std::string &path) const;
+        std::optional<size_t> restore_snapshot(const std::string &path);
+
+        /**
+         * @brief Restore the selection saved at path, then keep every change saved there
+         *
+         * Changes are appended to path + ".log" in the background and folded
+         * into the snapshot at path from time to time (see AutosaveLog), so a
+         * crash or a dropped connection loses at most the last sync interval.
+         * Lazy sections with saved state are loaded to restore it. Items that
+         * arrive later, from an item feed or a watched file, get their saved
+         * state when they are added. run() calls this for
+         * Config::autosave_path and disables autosave on exit.
+         *
+         * @return false if the autosave log can't be opened
+         */
+        bool enable_autosave(const std::string &path);
+
+        /**
+         * @brief Sync and fold what was logged, then stop saving changes
+         */
+        void disable_autosave() { autosave_.reset(); }
+        [[nodiscard]] bool autosave_enabled() const { return autosave_ != nullptr; }
+
+        /**
+         * @brief Change selections from a script or the command line
+         *
+         * One command per entry, stopping at the first that fails:
+         *
+         * - `Section/Item` or `+Section/Item` selects, `-Section/Item` deselects
+         * - `*` as the item selects the whole section, or clears it with a leading `-`
+         * - `@path` restores a snapshot written by save_snapshot()
+         *
+         * Section names are matched whole, so both names may contain '/'.
+         * Constraints apply as for a toggle. Blank entries and entries starting
+         * with '#' are skipped; surrounding whitespace is ignored.
+         *
+         * @return false if a command failed; command_problem() says which and why
+         */
+        bool apply_selection_commands(std::span<const std::string> commands);
+
+        /**
+         * @brief apply_selection_commands() with the lines of a file
+         */
+        bool apply_selection_script(const std::string &path);
+
+        [[nodiscard]] const std::string &command_problem() const { return command_problem_; }
+
         /*
          * Event callbacks
          */
@@ -186,6 +606,15 @@ namespace tui {
         void set_exit_callback(ExitCallback callback);
         void set_custom_command_callback(CustomCommandCallback callback);
 
+        /**
+         * @brief Subscribe to selection changes made through this NavigationTUI
+         *
+         * Changes are delivered in batches: a keypress that selects a whole section
+         * results in one call per observer.
+         */
+        SubscriptionId subscribe(SelectionEventBus::Observer observer, const ChangeFilter &filter = {});
+        bool unsubscribe(SubscriptionId id);
+
         /*
          * Navigation state
          */
@@ -220,6 +649,18 @@ namespace tui {
         /*
          * Other methods
          */
+
+        /**
+         * @brief Run the session until the user quits
+         *
+         * Applies Config::selection_script and Config::selection_commands
+         * first. In headless mode (Config::run_mode) that is all: once async
+         * sections have finished loading the commands are applied and the
+         * exit callback fires, without touching the terminal. If a command
+         * fails, or sections are still loading after
+         * Config::headless_load_timeout, a headless run reports it on stderr
+         * and skips the exit callback.
+         */
         void run();
         void exit();
 
@@ -243,7 +684,13 @@ namespace tui {
 
     private:
         void initialize();
+        bool apply_configured_commands();
+        void run_headless();
+        void finish_run();
         void process_events();
+        void drain_item_feed();
+        void apply_file_reloads();
+        void animate_loading();
 
         void handle_input(TerminalUtils::Key key, char character);
         void draw_border(int top, int left, int width, int height) const;
@@ -259,6 +706,48 @@ namespace tui {
          */
         void render_item_selection(int start_row, int left_padding, int content_width);
 
+        /**
+         * @brief Render a single row; index/position is the global display position
+         */
+        void render_section_row(size_t index, int row, int left_padding, int content_width);
+        void render_item_row(const section_type &section, size_t position, int row, int left_padding,
+                             int content_width);
+        void render_empty_section(int row, int left_padding, int content_width);
+        [[nodiscard]] std::string section_row_text(size_t index, bool highlighted) const;
+        [[nodiscard]] std::string_view item_label(const section_type &section, size_t index) const;
+
+        /**
+         * @brief Provider description of a row, nullopt while it is being produced
+         */
+        [[nodiscard]] std::optional<std::string> provided_description(const section_type &section, size_t index);
+
+        /**
+         * @brief Page cache: build (or reuse) the rows of a page, and warm up neighbours when idle
+         */
+        const PrerenderedPage &prerender_page(NavigationState state, int page, int content_width);
+        [[nodiscard]] bool is_page_current(const PrerenderedPage &page) const;
+        void prerender_adjacent_pages();
+        [[nodiscard]] std::string_view spinner_glyph() const;
+
+        /**
+         * @brief Repaint placeholder rows and descriptions once they have been delivered
+         */
+        void refresh_loaded_rows();
+
+        /**
+         * @brief Jump-to-item prompt: index upkeep, input and rendering
+         */
+        void sync_search_index(bool force = false);
+        void handle_search_input(TerminalUtils::Key key, char character);
+        void update_search();
+        void render_search(int start_row, int left_padding, int content_width);
+
+        /**
+         * @brief Partial redraw of rows queued with invalidate_row()
+         */
+        void invalidate_row(size_t position);
+        void render_dirty_rows();
+
         /**
          * @brief Render header with title
          */
@@ -268,7 +757,8 @@ namespace tui {
          * @brief Render footer with help text and page info
          */
         // void render_footer(int term_height, int left_padding, int content_width) const;
-        void render_footer(int term_height, int left_padding, int content_width, const SelectableItem *item);
+        void render_footer(int term_height, int left_padding, int content_width,
+                           std::optional<std::string_view> item_description = std::nullopt);
 
         /**
          * @brief Handle input in section selection mode
@@ -288,6 +778,43 @@ namespace tui {
         void select_current_item();
         void toggle_current_item();
         void handle_number_input(char digit);
+        void apply_number_input();
+        void handle_goto_input(TerminalUtils::Key key, char character);
+
+        /**
+         * @brief Jump to "N" (section N, or item N inside a section) or "pN" (page N), 1-based
+         */
+        void go_to(std::string_view target);
+        void move_cursor_to(size_t position);
+
+        /**
+         * @brief Type-ahead: extend the prefix with character and jump to the first match
+         *
+         * @return False if the key wasn't consumed (type-ahead off, or an uppercase command or digit starting a prefix)
+         */
+        bool handle_type_ahead(char character);
+        [[nodiscard]] bool is_type_ahead_pending() const;
+        [[nodiscard]] std::optional<size_t> find_prefix(const section_type &section, std::string_view prefix);
+
+        /**
+         * @brief Run a mutation on a section and publish its changes as one batch
+         */
+        template <typename Fn>
+        void batch_section(size_t section_index, Fn &&fn);
+        void publish_changes(size_t section_index, std::span<const ItemChange> changes);
+        void restore_autosaved(size_t section_index, size_t first);
+        bool replay(const SelectionJournal::Entry &entry, bool forward);
+
+        /**
+         * @brief Split all items into chunks and run fn(chunk, section_index, first, last) on the pool
+         *
+         * Pieces of sources that can't be read concurrently run on the calling
+         * thread once the pool is done, so a chunk may be reported in two goes.
+         *
+         * @return Number of chunks
+         */
+        size_t scan_items(const std::function<void(size_t chunk, size_t section_index, size_t first, size_t last)> &fn)
+            const;
 
         /**
          * @brief Pagination helpers
@@ -301,7 +828,8 @@ namespace tui {
          */
         // [[nodiscard]] std::vector<std::string> get_section_display_items() const;
         // [[nodiscard]] std::vector<std::string> get_current_item_display_items() const;
-        [[nodiscard]] std::string format_item_with_theme(const SelectableItem &item, bool is_selected) const;
+        [[nodiscard]] std::string format_item_with_theme(std::string_view name, bool item_selected,
+                                                         bool is_selected) const;
         [[nodiscard]] std::string get_page_info_string() const;
 
         void apply_gradient_text(const std::string &text, int row, int col) const;
@@ -322,6 +850,33 @@ namespace tui {
          */
         void change_state(NavigationState new_state);
 
+        /**
+         * @brief Section storage helpers (index = display position)
+         */
+        section_type &section_at(size_t index);
+        [[nodiscard]] const section_type &section_at(size_t index) const;
+        [[nodiscard]] size_t storage_index_at(size_t index) const;
+        void compact_section_order() const;
+        void register_new_sections();
+
+        /**
+         * @brief Lazy section helpers
+         */
+        LazySection *find_lazy(SectionHandle handle);
+        bool reconcile_sections(std::vector<section_type> &&sections, SectionHandle only);
+        [[nodiscard]] static std::optional<FileReload> load_watched_file(const WatchedFile &file);
+        void queue_file_reload(const std::string &path);
+        bool apply_file_reload(FileReload &&reload);
+        [[nodiscard]] const LazySection *find_lazy(SectionHandle handle) const;
+        void load_lazy_section(LazySection &lazy);
+        void unload_lazy_section(LazySection &lazy);
+        void evict_lazy_sections();
+        void load_lazy_selections();
+        [[nodiscard]] std::vector<std::string> selected_names(size_t storage_index) const;
+        [[nodiscard]] std::pair<size_t, size_t> section_counts(size_t index) const;
+        void remove_section_storage(size_t storage_index);
+        void compact_sections();
+
         /**
          * @brief Utility methods
          */
@@ -342,17 +897,24 @@ namespace tui {
     /**
      * @brief Builder class for easy NavigationTUI configuration
      */
-    class NavigationBuilder {
-        NavigationTUI::Config config_;
-        std::vector<Section> sections_;
+    template <typename SectionT = Section>
+    class BasicNavigationBuilder {
+    public:
+        using tui_type = BasicNavigationTUI<SectionT>;
+        using section_type = SectionT;
+
+    private:
+        typename tui_type::Config config_;
+        std::vector<section_type> sections_;
 
         // Callbacks
-        NavigationTUI::SectionSelectedCallback section_selected_callback_;
-        NavigationTUI::ItemToggledCallback item_toggled_callback_;
-        NavigationTUI::PageChangedCallback page_changed_callback_;
-        NavigationTUI::StateChangedCallback state_changed_callback_;
-        NavigationTUI::ExitCallback exit_callback_;
-        NavigationTUI::CustomCommandCallback custom_command_callback_;
+        typename tui_type::SectionSelectedCallback section_selected_callback_;
+        typename tui_type::ItemToggledCallback item_toggled_callback_;
+        typename tui_type::PageChangedCallback page_changed_callback_;
+        typename tui_type::StateChangedCallback state_changed_callback_;
+        typename tui_type::ExitCallback exit_callback_;
+        typename tui_type::CustomCommandCallback custom_command_callback_;
+        typename tui_type::DescriptionProvider description_provider_;
 
     public:
         /*
@@ -363,83 +925,134 @@ namespace tui {
         /**
          * @brief Theme configuration methods
          */
-        NavigationBuilder &theme_indicators(char selected, char unselected);
-        NavigationBuilder &theme_prefixes(const std::string &selected, const std::string &unselected);
-        NavigationBuilder &theme_unicode(bool enable);
-        NavigationBuilder &theme_colors(bool enable);
-        NavigationBuilder &theme_gradient_support(bool enable);
-        NavigationBuilder &theme_gradient_preset(const tui_extras::GradientPreset &preset);
-        NavigationBuilder &theme_gradient_randomize(bool enable);
-        NavigationBuilder &theme_border_style(const tui_extras::BorderStyle &style);
-        NavigationBuilder &theme_accent_color(const tui_extras::AccentColor &color);
+        BasicNavigationBuilder &theme_indicators(char selected, char unselected);
+        BasicNavigationBuilder &theme_prefixes(const std::string &selected, const std::string &unselected);
+        BasicNavigationBuilder &theme_unicode(bool enable);
+        BasicNavigationBuilder &theme_colors(bool enable);
+        BasicNavigationBuilder &theme_gradient_support(bool enable);
+        BasicNavigationBuilder &theme_gradient_preset(const tui_extras::GradientPreset &preset);
+        BasicNavigationBuilder &theme_gradient_randomize(bool enable);
+        BasicNavigationBuilder &theme_border_style(const tui_extras::BorderStyle &style);
+        BasicNavigationBuilder &theme_accent_color(const tui_extras::AccentColor &color);
 
         /**
          * @brief Layout configuration methods
          */
-        NavigationBuilder &layout_centering(bool horizontal, bool vertical);
-        NavigationBuilder &layout_content_width(int min_width, int max_width);
-        NavigationBuilder &layout_padding(int vertical_padding);
-        NavigationBuilder &layout_auto_resize(bool enable);
-        NavigationBuilder &layout_borders(bool show);
-        NavigationBuilder &layout_items_per_page(int count);
-        NavigationBuilder &layout_sections_per_page(int count);
-        NavigationBuilder &paginate_sections(bool paginate);
+        BasicNavigationBuilder &layout_centering(bool horizontal, bool vertical);
+        BasicNavigationBuilder &layout_content_width(int min_width, int max_width);
+        BasicNavigationBuilder &layout_padding(int vertical_padding);
+        BasicNavigationBuilder &layout_auto_resize(bool enable);
+        BasicNavigationBuilder &layout_borders(bool show);
+        BasicNavigationBuilder &layout_items_per_page(int count);
+        BasicNavigationBuilder &layout_sections_per_page(int count);
+        BasicNavigationBuilder &paginate_sections(bool paginate);
 
         /**
          * @brief Text configuration methods
          */
-        NavigationBuilder &text_titles(const std::string &section_title, const std::string &item_prefix);
-        NavigationBuilder &text_messages(const std::string &empty_message);
-        NavigationBuilder &text_help(const std::string &section_help, const std::string &item_help);
-        NavigationBuilder &text_show_help(bool show);
-        NavigationBuilder &text_show_pages(bool show);
-        NavigationBuilder &text_show_counters(bool show);
+        BasicNavigationBuilder &text_titles(const std::string &section_title, const std::string &item_prefix);
+        BasicNavigationBuilder &text_messages(const std::string &empty_message);
+        BasicNavigationBuilder &text_help(const std::string &section_help, const std::string &item_help);
+        BasicNavigationBuilder &text_show_help(bool show);
+        BasicNavigationBuilder &text_show_pages(bool show);
+        BasicNavigationBuilder &text_show_counters(bool show);
 
         /**
          * @brief Keyboard configuration methods
          */
-        NavigationBuilder &keys_quick_select(bool enable);
-        NavigationBuilder &keys_vim_style(bool enable);
-        NavigationBuilder &keys_custom_shortcut(char key, const std::string &description);
+        BasicNavigationBuilder &keys_quick_select(bool enable);
+        BasicNavigationBuilder &keys_vim_style(bool enable);
+        BasicNavigationBuilder &keys_type_ahead(bool enable);
+        BasicNavigationBuilder &keys_custom_shortcut(char key, const std::string &description);
+
+        /**
+         * @brief Memory budget for lazy sections, see NavigationTUI::add_lazy_section()
+         */
+        BasicNavigationBuilder &lazy_memory_budget(size_t bytes);
+
+        /**
+         * @brief On-demand descriptions, see NavigationTUI::set_description_provider()
+         */
+        BasicNavigationBuilder &description_provider(typename tui_type::DescriptionProvider provider,
+                                                size_t cache_entries = 256);
+
+        /**
+         * @brief Selection batches kept for undo, 0 disables the journal
+         */
+        BasicNavigationBuilder &undo_history(size_t entries);
+
+        /**
+         * @brief Keep the selection saved at path while running, see NavigationTUI::enable_autosave()
+         */
+        BasicNavigationBuilder &autosave(const std::string &path);
+
+        /**
+         * @brief Headless or interactive, see NavigationTUI::RunMode
+         */
+        BasicNavigationBuilder &run_mode(typename tui_type::RunMode mode);
+
+        /**
+         * @brief How long a headless run waits for async sections, 0 = no limit
+         */
+        BasicNavigationBuilder &headless_load_timeout(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Selection commands applied when run() starts, see NavigationTUI::apply_selection_commands()
+         */
+        BasicNavigationBuilder &selection_commands(std::vector<std::string> commands);
+        BasicNavigationBuilder &selection_script(const std::string &path);
 
         /**
          * @brief Section management methods
          */
-        NavigationBuilder &add_section(const Section &section);
-        NavigationBuilder &add_section(Section &&section);
-        NavigationBuilder &add_sections(const std::vector<Section> &sections);
+        BasicNavigationBuilder &add_section(const section_type &section);
+        BasicNavigationBuilder &add_section(section_type &&section);
+        BasicNavigationBuilder &add_sections(const std::vector<section_type> &sections);
 
         /**
          * @brief Callback configuration methods
          */
-        NavigationBuilder &on_section_selected(NavigationTUI::SectionSelectedCallback callback);
-        NavigationBuilder &on_item_toggled(NavigationTUI::ItemToggledCallback callback);
-        NavigationBuilder &on_page_changed(NavigationTUI::PageChangedCallback callback);
-        NavigationBuilder &on_state_changed(NavigationTUI::StateChangedCallback callback);
-        NavigationBuilder &on_exit(NavigationTUI::ExitCallback callback);
-        NavigationBuilder &on_custom_command(NavigationTUI::CustomCommandCallback callback);
+        BasicNavigationBuilder &on_section_selected(typename tui_type::SectionSelectedCallback callback);
+        BasicNavigationBuilder &on_item_toggled(typename tui_type::ItemToggledCallback callback);
+        BasicNavigationBuilder &on_page_changed(typename tui_type::PageChangedCallback callback);
+        BasicNavigationBuilder &on_state_changed(typename tui_type::StateChangedCallback callback);
+        BasicNavigationBuilder &on_exit(typename tui_type::ExitCallback callback);
+        BasicNavigationBuilder &on_custom_command(typename tui_type::CustomCommandCallback callback);
 
         /**
          * @brief Pre-configured themes
          */
-        NavigationBuilder &theme_minimal();
-        NavigationBuilder &theme_fancy();
-        NavigationBuilder &theme_retro();
-        NavigationBuilder &theme_modern();
+        BasicNavigationBuilder &theme_minimal();
+        BasicNavigationBuilder &theme_fancy();
+        BasicNavigationBuilder &theme_retro();
+        BasicNavigationBuilder &theme_modern();
 
         /**
          * @brief Pre-configured layouts
          */
-        NavigationBuilder &layout_compact();
-        NavigationBuilder &layout_comfortable();
-        NavigationBuilder &layout_fullscreen();
-        NavigationBuilder &layout_centered();
+        BasicNavigationBuilder &layout_compact();
+        BasicNavigationBuilder &layout_comfortable();
+        BasicNavigationBuilder &layout_fullscreen();
+        BasicNavigationBuilder &layout_centered();
 
-        std::unique_ptr<NavigationTUI> build();
+        std::unique_ptr<tui_type> build();
 
-        [[nodiscard]] const NavigationTUI::Config &get_config() const;
+        [[nodiscard]] const typename tui_type::Config &get_config() const;
 
-        NavigationBuilder &reset();
+        BasicNavigationBuilder &reset();
     };
 
+    using NavigationTUI = BasicNavigationTUI<Section>;           ///< TUI over type-erased sections (default)
+    using PlainNavigationTUI = BasicNavigationTUI<PlainSection>; ///< TUI over sections without user data
+    using NavigationBuilder = BasicNavigationBuilder<Section>;
+    using PlainNavigationBuilder = BasicNavigationBuilder<PlainSection>;
+
+    // instantiated once in navigation_tui.cpp
+    extern template class BasicNavigationTUI<Section>;
+    extern template class BasicNavigationTUI<PlainSection>;
+    extern template class BasicNavigationBuilder<Section>;
+    extern template class BasicNavigationBuilder<PlainSection>;
+
 } // namespace tui
+
+#include "navigation_tui_impl.hpp"
@@ -0,0 +1,3591 @@
+#pragma once
+
+#include "navigation_tui.hpp"
+#include "styles.hpp"
+#include "terminal_utils.hpp"
+#include "thread_pool.hpp"
+
+#include <bit>
+#include <charconv>
+#include <climits>
+#include <limits>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+// Member definitions of BasicNavigationTUI and BasicNavigationBuilder, included by navigation_tui.hpp
+
+namespace tui {
+    namespace detail {
+        /// Marks a section_order_ entry whose section was removed, until compact_section_order()
+        inline constexpr uint32_t removed_section_position = std::numeric_limits<uint32_t>::max();
+
+        inline bool folded_equal(const char a, const char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        }
+
+        // identifies a list of items by their names and order, for telling whether indices still match
+        template <typename SectionT>
+        uint64_t names_hash(const SectionT &section) {
+            uint64_t hash = section.size();
+            for (size_t index = 0; index < section.size(); ++index) {
+                hash = (std::rotl(hash, 5) ^ snapshot_hash(section.item_name(index))) * 0x100000001B3ULL;
+            }
+            return hash;
+        }
+
+        inline bool folded_less(const std::string_view a, const std::string_view b) {
+            return std::ranges::lexicographical_compare(a, b, [](const char x, const char y) {
+                return std::tolower(static_cast<unsigned char>(x)) < std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        // Feeds, parsers and file reloads hand over type-erased items; typed sections take the payload back out
+        template <typename ItemT>
+        std::vector<ItemT> adopt_items(std::vector<SelectableItem> &&items) {
+            if constexpr (std::is_same_v<ItemT, SelectableItem>) {
+                return std::move(items);
+            } else {
+                std::vector<ItemT> adopted;
+                adopted.reserve(items.size());
+                for (auto &item : items) {
+                    auto &typed = adopted.emplace_back(std::move(item.name), std::move(item.description), item.id);
+                    typed.selected = item.selected;
+                    if constexpr (!std::is_same_v<typename ItemT::payload_type, NoPayload>) {
+                        if (auto *payload = std::any_cast<typename ItemT::payload_type>(&item.user_data)) {
+                            typed.user_data = std::move(*payload);
+                        }
+                    }
+                }
+                return adopted;
+            }
+        }
+
+        template <typename ItemT>
+        std::vector<SelectableItem> erase_items(std::vector<ItemT> &&items) {
+            if constexpr (std::is_same_v<ItemT, SelectableItem>) {
+                return std::move(items);
+            } else {
+                std::vector<SelectableItem> erased;
+                erased.reserve(items.size());
+                for (auto &item : items) {
+                    auto &plain = erased.emplace_back(std::move(item.name), std::move(item.description), item.id);
+                    plain.selected = item.selected;
+                    if constexpr (!std::is_same_v<typename ItemT::payload_type, NoPayload>) {
+                        plain.user_data = std::move(item.user_data);
+                    }
+                }
+                return erased;
+            }
+        }
+    } // namespace detail
+
+    template <typename SectionT>
+    BasicNavigationTUI<SectionT>::BasicNavigationTUI() :
+        current_state_(NavigationState::MAIN_MENU), current_section_index_(0), current_selection_index_(0),
+        current_page_(0), current_section_page_{0}, running_(false), needs_redraw_(true), previous_width_{0},
+        previous_height_{0} {
+        config_ = Config{};
+        terminal_manager_ = std::make_unique<TerminalManager>();
+    }
+
+    template <typename SectionT>
+    BasicNavigationTUI<SectionT>::BasicNavigationTUI(Config config) :
+        current_state_(NavigationState::MAIN_MENU), current_section_index_(0), current_selection_index_(0),
+        current_page_(0), current_section_page_{0}, config_(std::move(config)), running_(false), needs_redraw_(true),
+        previous_width_{0}, previous_height_{0} {
+        terminal_manager_ = std::make_unique<TerminalManager>();
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::add_section(const SectionT &section) {
+        sections_.push_back(section);
+        register_new_sections();
+        sync_search_index(true);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::add_section(SectionT &&section) {
+        sections_.push_back(std::move(section));
+        register_new_sections();
+        sync_search_index(true);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::add_sections(const std::vector<SectionT> &sections) {
+        sections_.insert(sections_.end(), sections.begin(), sections.end());
+        register_new_sections();
+        sync_search_index(true);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::add_sections(std::vector<SectionT> &&sections) {
+        sections_.insert(sections_.end(), std::make_move_iterator(sections.begin()),
+                         std::make_move_iterator(sections.end()));
+        register_new_sections();
+        sync_search_index(true);
+    }
+
+    template <typename SectionT>
+    SectionT *BasicNavigationTUI<SectionT>::get_section(size_t index) {
+        return (index < sections_.size()) ? &section_at(index) : nullptr;
+    }
+
+    template <typename SectionT>
+    const SectionT *BasicNavigationTUI<SectionT>::get_section(size_t index) const {
+        return (index < sections_.size()) ? &section_at(index) : nullptr;
+    }
+
+    template <typename SectionT>
+    SectionT *BasicNavigationTUI<SectionT>::get_section(const SectionHandle handle) {
+        const auto storage_index = section_slots_.find(handle);
+        return storage_index ? &sections_[*storage_index] : nullptr;
+    }
+
+    template <typename SectionT>
+    const SectionT *BasicNavigationTUI<SectionT>::get_section(const SectionHandle handle) const {
+        const auto storage_index = section_slots_.find(handle);
+        return storage_index ? &sections_[*storage_index] : nullptr;
+    }
+
+    template <typename SectionT>
+    SectionHandle BasicNavigationTUI<SectionT>::get_section_handle(const size_t index) const {
+        return (index < sections_.size()) ? section_handles_[storage_index_at(index)] : SectionHandle{};
+    }
+
+    template <typename SectionT>
+    std::optional<size_t> BasicNavigationTUI<SectionT>::get_section_index(const SectionHandle handle) const {
+        const auto storage_index = section_slots_.find(handle);
+        if (!storage_index) {
+            return std::nullopt;
+        }
+        if (removed_section_positions_ > 0) {
+            compact_section_order();
+        }
+        return section_order_.empty() ? *storage_index : size_t{section_positions_[*storage_index]};
+    }
+
+    template <typename SectionT>
+    SectionT *BasicNavigationTUI<SectionT>::get_section_by_name(const std::string &name) {
+        const auto it =
+            std::ranges::find_if(sections_, [&name](const SectionT &section) { return section.name == name; });
+        return (it != sections_.end()) ? &(*it) : nullptr;
+    }
+
+    template <typename SectionT>
+    const SectionT *BasicNavigationTUI<SectionT>::get_section_by_name(const std::string &name) const {
+        const auto it =
+            std::ranges::find_if(sections_, [&name](const SectionT &section) { return section.name == name; });
+        return (it != sections_.end()) ? &(*it) : nullptr;
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::get_section_count() const { return sections_.size(); }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::remove_section(const size_t index) {
+        if (index < sections_.size()) {
+            remove_section_storage(storage_index_at(index));
+            validate_indices();
+            return true;
+        }
+        return false;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::remove_section(const SectionHandle handle) {
+        if (const auto storage_index = section_slots_.find(handle)) {
+            remove_section_storage(*storage_index);
+            validate_indices();
+            return true;
+        }
+        return false;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::remove_section_by_name(const std::string &name) {
+        const auto it =
+            std::ranges::find_if(sections_, [&name](const SectionT &section) { return section.name == name; });
+        if (it != sections_.end()) {
+            remove_section_storage(static_cast<size_t>(it - sections_.begin()));
+            validate_indices();
+            return true;
+        }
+        return false;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::clear_sections() {
+        for (const auto handle : section_handles_) {
+            section_slots_.release(handle);
+        }
+        sections_.clear();
+        section_handles_.clear();
+        section_order_.clear();
+        section_positions_.clear();
+        removed_section_positions_ = 0;
+        lazy_sections_.clear();
+        loading_sections_.clear();
+        search_index_.clear();
+        search_hits_.clear();
+        current_section_index_ = 0;
+        current_selection_index_ = 0;
+        current_page_ = 0;
+        current_state_ = NavigationState::MAIN_MENU;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::reconcile(std::vector<SectionT> &&sections) {
+        return reconcile_sections(std::move(sections), {});
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::reconcile_section(const SectionHandle handle, SectionT &&fresh) {
+        if (!get_section(handle)) {
+            return false;
+        }
+        std::vector<SectionT> sections;
+        sections.push_back(std::move(fresh));
+        return reconcile_sections(std::move(sections), handle);
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::reconcile_sections(std::vector<SectionT> &&sections, const SectionHandle only) {
+        const bool in_items = current_state_ == NavigationState::ITEM_SELECTION;
+        const int old_total_pages = calculate_total_pages();
+        const int old_page = in_items ? current_page_ : current_section_page_;
+        const size_t old_selection = current_selection_index_;
+        const size_t old_count = sections_.size();
+        const size_t old_rows = in_items ? get_current_page_bounds().second - get_current_page_bounds().first
+                                         : static_cast<size_t>(get_sections_on_current_page());
+        const size_t old_cursor = in_items
+            ? current_page_ * config_.layout.items_per_page + current_selection_index_
+            : current_section_page_ * config_.layout.sections_per_page + current_selection_index_;
+
+        // Anchors: what the user is looking at, by handle
+        const SectionHandle current_section = get_section_handle(current_section_index_);
+        const SectionHandle highlighted_section = in_items ? SectionHandle{} : get_section_handle(old_cursor);
+        ItemHandle highlighted_item;
+        if (in_items && current_section_index_ < sections_.size()) {
+            const auto &section = section_at(current_section_index_);
+            if (old_cursor < section.size()) {
+                highlighted_item = section.handle_of(section.index_at(old_cursor));
+            }
+        }
+
+        std::vector<SectionHandle> old_sequence(sections_.size());
+        std::unordered_map<std::string, std::vector<SectionHandle>> by_name;
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            old_sequence[i] = get_section_handle(i);
+            if (!only.valid()) {
+                by_name[section_at(i).name].push_back(old_sequence[i]);
+            }
+        }
+
+        bool changed = false;
+        std::vector<SectionHandle> new_sequence;
+        std::unordered_set<uint32_t> restated; ///< Handle slots of sections whose row text changed
+        std::vector<size_t> current_dirty;
+        bool current_replaced = false;
+        new_sequence.reserve(sections.size());
+
+        for (auto &fresh : sections) {
+            SectionHandle handle = only;
+            if (const auto it = by_name.find(fresh.name); it != by_name.end() && !it->second.empty()) {
+                handle = it->second.front();
+                it->second.erase(it->second.begin());
+            }
+            if (handle.valid()) {
+                auto result = get_section(handle)->reconcile(std::move(fresh));
+                changed = changed || result.changed();
+                // the row shows the counts and the description
+                if (result.inserted > 0 || result.removed > 0 || result.updated > 0 || result.section_changed ||
+                    result.replaced) {
+                    restated.insert(handle.slot);
+                }
+                if (handle == current_section) {
+                    current_dirty = std::move(result.dirty_positions);
+                    current_replaced = result.replaced;
+                }
+                new_sequence.push_back(handle);
+            } else {
+                sections_.push_back(std::move(fresh));
+                register_new_sections();
+                new_sequence.push_back(section_handles_.back());
+                changed = true;
+            }
+        }
+
+        if (only.valid()) {
+            // the rest of the sections stay where they are
+            new_sequence = old_sequence;
+        }
+        for (const auto &handles : by_name | std::views::values) {
+            for (const auto handle : handles) {
+                remove_section_storage(*section_slots_.find(handle));
+                changed = true;
+            }
+        }
+
+        section_order_.resize(new_sequence.size());
+        section_positions_.resize(new_sequence.size());
+        removed_section_positions_ = 0;
+        bool identity = true;
+        for (size_t i = 0; i < new_sequence.size(); ++i) {
+            section_order_[i] = static_cast<uint32_t>(*section_slots_.find(new_sequence[i]));
+            section_positions_[section_order_[i]] = static_cast<uint32_t>(i);
+            identity = identity && section_order_[i] == i;
+        }
+        if (identity) {
+            section_order_.clear();
+            section_positions_.clear();
+        }
+        changed = changed || new_sequence != old_sequence;
+
+        if (!changed) {
+            return false;
+        }
+
+        // Put the cursor back on the anchors
+        if (const auto index = get_section_index(current_section)) {
+            current_section_index_ = *index;
+        } else if (in_items) {
+            change_state(NavigationState::MAIN_MENU);
+            current_page_ = 0;
+        }
+
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            size_t position = old_cursor;
+            if (const auto index = get_section_index(highlighted_section)) {
+                position = *index;
+            } else if (in_items) {
+                position = current_section_index_;
+            }
+            position = std::min(position, !sections_.empty() ? sections_.size() - 1 : 0);
+            current_section_page_ = static_cast<int>(position / config_.layout.sections_per_page);
+            current_selection_index_ = position % config_.layout.sections_per_page;
+        } else {
+            const auto &section = section_at(current_section_index_);
+            size_t position = old_cursor;
+            if (const auto index = section.index_of(highlighted_item)) {
+                position = section.position_of(*index);
+            }
+            position = std::min(position, !section.empty() ? section.size() - 1 : 0);
+            current_page_ = static_cast<int>(position / config_.layout.items_per_page);
+            current_selection_index_ = position % config_.layout.items_per_page;
+        }
+        validate_indices();
+
+        // Repaint everything if the layout moved, otherwise just the changed rows
+        const size_t new_rows = in_items ? get_current_page_bounds().second - get_current_page_bounds().first
+                                         : static_cast<size_t>(get_sections_on_current_page());
+        const int new_page = in_items ? current_page_ : current_section_page_;
+        if (current_state_ != (in_items ? NavigationState::ITEM_SELECTION : NavigationState::MAIN_MENU) ||
+            calculate_total_pages() != old_total_pages || new_page != old_page || new_rows != old_rows ||
+            (!in_items && sections_.size() != old_count) || (in_items && current_replaced)) {
+            needs_redraw_ = true;
+            return true;
+        }
+
+        const size_t cursor = old_cursor - old_selection + current_selection_index_;
+        if (in_items) {
+            // The footer shows the description of the highlighted item
+            if (std::ranges::find(current_dirty, cursor) != current_dirty.end()) {
+                needs_redraw_ = true;
+                return true;
+            }
+            for (const size_t position : current_dirty) {
+                invalidate_row(position);
+            }
+        } else {
+            for (size_t i = 0; i < new_sequence.size(); ++i) {
+                if (i >= old_sequence.size() || old_sequence[i] != new_sequence[i] ||
+                    restated.contains(new_sequence[i].slot)) {
+                    invalidate_row(i);
+                }
+            }
+        }
+        if (cursor != old_cursor) {
+            invalidate_row(old_cursor);
+            invalidate_row(cursor);
+        }
+
+        return true;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::watch_section_file(const SectionHandle handle, const std::string &path,
+                                                          const ItemFileFormat format) {
+        const SectionT *section = get_section(handle);
+        if (!section || find_lazy(handle)) {
+            return false;
+        }
+        WatchedFile file{handle, path, format, section->name};
+
+        // the first load is synchronous, so a missing or broken file is reported here
+        auto reload = load_watched_file(file);
+        if (!reload) {
+            return false;
+        }
+        unwatch_section_file(handle);
+        if (!file_watcher_) {
+            file_watcher_ = std::make_unique<FileWatcher>([this](const std::string &changed) {
+                queue_file_reload(changed);
+            });
+        }
+        if (!file_watcher_->watch(path)) {
+            return false;
+        }
+        {
+            std::lock_guard lock(reload_mutex_);
+            watched_files_.push_back(std::move(file));
+        }
+        apply_file_reload(std::move(*reload));
+        return true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::unwatch_section_file(const SectionHandle handle) {
+        std::string path;
+        bool shared = false;
+        {
+            std::lock_guard lock(reload_mutex_);
+            const auto it = std::ranges::find(watched_files_, handle, &WatchedFile::handle);
+            if (it == watched_files_.end()) {
+                return;
+            }
+            path = std::move(it->path);
+            watched_files_.erase(it);
+            std::erase_if(file_reloads_, [handle](const FileReload &reload) { return reload.handle == handle; });
+            shared = std::ranges::find(watched_files_, path, &WatchedFile::path) != watched_files_.end();
+        }
+        // another section may read the same file, e.g. a different INI block
+        if (!shared) {
+            file_watcher_->unwatch(path);
+        }
+    }
+
+    template <typename SectionT>
+    std::optional<typename BasicNavigationTUI<SectionT>::FileReload> BasicNavigationTUI<SectionT>::load_watched_file(
+        const WatchedFile &file) {
+        // read into memory, never mapped: an in-place write would truncate a live mapping
+        auto items = load_items(file.path, file.format, file.section_name);
+        if (!items) {
+            return std::nullopt;
+        }
+        return FileReload{file.handle, std::move(*items)};
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::queue_file_reload(const std::string &path) {
+        std::vector<WatchedFile> files;
+        {
+            std::lock_guard lock(reload_mutex_);
+            for (const auto &file : watched_files_) {
+                if (file.path == path) {
+                    files.push_back(file);
+                }
+            }
+        }
+
+        // watcher thread: parse here, apply between frames
+        for (const auto &file : files) {
+            auto reload = load_watched_file(file);
+            if (!reload) {
+                continue;
+            }
+            std::lock_guard lock(reload_mutex_);
+            if (std::ranges::find(watched_files_, file.handle, &WatchedFile::handle) == watched_files_.end()) {
+                continue;
+            }
+            if (const auto it = std::ranges::find(file_reloads_, file.handle, &FileReload::handle);
+                it != file_reloads_.end()) {
+                *it = std::move(*reload);
+            } else {
+                file_reloads_.push_back(std::move(*reload));
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::apply_file_reloads() {
+        std::vector<FileReload> reloads;
+        {
+            std::lock_guard lock(reload_mutex_);
+            if (file_reloads_.empty()) {
+                return;
+            }
+            reloads.swap(file_reloads_);
+        }
+        for (auto &reload : reloads) {
+            const SectionHandle handle = reload.handle;
+            if (!apply_file_reload(std::move(reload)) && !get_section(handle)) {
+                // the section was removed since
+                unwatch_section_file(handle);
+            }
+        }
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::apply_file_reload(FileReload &&reload) {
+        const SectionT *section = get_section(reload.handle);
+        if (!section) {
+            return false;
+        }
+        SectionT fresh(section->name, section->description);
+        fresh.items = detail::adopt_items<item_type>(std::move(reload.items));
+        const bool changed = reconcile_section(reload.handle, std::move(fresh));
+        // rows the file brings back get their saved state rather than the file's
+        if (const auto index = get_section_index(reload.handle); changed && index) {
+            restore_autosaved(*index, 0);
+        }
+        return changed;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_section_selected_callback(SectionSelectedCallback callback) {
+        on_section_selected_ = std::move(callback);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_item_toggled_callback(ItemToggledCallback callback) {
+        if (item_toggled_subscription_ != 0) {
+            selection_events_.unsubscribe(item_toggled_subscription_);
+            item_toggled_subscription_ = 0;
+        }
+        if (callback) {
+            item_toggled_subscription_ =
+                selection_events_.subscribe([callback = std::move(callback)](std::span<const SelectionChange> changes) {
+                    for (const auto &change : changes) {
+                        callback(change.section_index, change.item_index, change.selected);
+                    }
+                });
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_page_changed_callback(PageChangedCallback callback) {
+        on_page_changed_ = std::move(callback);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_state_changed_callback(StateChangedCallback callback) {
+        on_state_changed_ = std::move(callback);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_exit_callback(ExitCallback callback) { on_exit_ = std::move(callback); }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_custom_command_callback(CustomCommandCallback callback) {
+        on_custom_command_ = std::move(callback);
+    }
+
+    template <typename SectionT>
+    SubscriptionId BasicNavigationTUI<SectionT>::subscribe(SelectionEventBus::Observer observer,
+                                                           const ChangeFilter &filter) {
+        return selection_events_.subscribe(std::move(observer), filter);
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::unsubscribe(const SubscriptionId id) {
+        return selection_events_.unsubscribe(id);
+    }
+
+    template <typename SectionT>
+    template <typename Fn>
+    void BasicNavigationTUI<SectionT>::batch_section(const size_t section_index, Fn &&fn) {
+        if (section_index >= sections_.size()) {
+            return;
+        }
+
+        auto &section = section_at(section_index);
+        section.begin_batch();
+        std::forward<Fn>(fn)(section);
+        publish_changes(section_index, section.end_batch());
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::publish_changes(const size_t section_index,
+                                                       std::span<const ItemChange> changes) {
+        if (!replaying_journal_ && !changes.empty()) {
+            journal_.set_limit(config_.undo_history);
+            journal_.record(get_section_handle(section_index), section_at(section_index).index_revision(), changes);
+        }
+        if (autosave_ && !restoring_autosave_) {
+            autosave_->append(section_at(section_index), changes);
+        }
+        if (changes.empty() || selection_events_.empty()) {
+            return;
+        }
+
+        std::vector<SelectionChange> batch;
+        batch.reserve(changes.size());
+        for (const auto &[item_index, selected] : changes) {
+            batch.push_back({section_index, item_index, selected});
+        }
+        selection_events_.publish(batch);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::restore_autosaved(const size_t section_index, const size_t first) {
+        if (!autosave_) {
+            return;
+        }
+        restoring_autosave_ = true;
+        batch_section(section_index, [&](SectionT &section) { autosave_->restore(section, first); });
+        restoring_autosave_ = false;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::replay(const SelectionJournal::Entry &entry, const bool forward) {
+        const auto section_index = get_section_index(entry.section);
+        if (!section_index || section_at(*section_index).index_revision() != entry.index_revision) {
+            return false;
+        }
+
+        replaying_journal_ = true;
+        batch_section(*section_index, [&](SectionT &section) {
+            entry.selected.for_each([&](const uint32_t item) { section.restore_item_selected(item, forward); });
+            entry.deselected.for_each([&](const uint32_t item) { section.restore_item_selected(item, !forward); });
+        });
+        replaying_journal_ = false;
+        needs_redraw_ = true;
+        return true;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::undo() {
+        while (auto entry = journal_.pop_undo()) {
+            if (replay(*entry, false)) {
+                journal_.push_redo(std::move(*entry));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::redo() {
+        while (auto entry = journal_.pop_redo()) {
+            if (replay(*entry, true)) {
+                journal_.push_undo(std::move(*entry));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::save_snapshot(const std::string &path) const {
+        SnapshotWriter writer;
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            writer.add(section_at(i));
+        }
+        return writer.write(path);
+    }
+
+    template <typename SectionT>
+    std::optional<size_t> BasicNavigationTUI<SectionT>::restore_snapshot(const std::string &path) {
+        const auto reader = SnapshotReader::open(path);
+        if (!reader) {
+            return std::nullopt;
+        }
+
+        size_t found = 0;
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            batch_section(i, [&](SectionT &section) { found += reader->apply(section); });
+        }
+        needs_redraw_ = true;
+        return found;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::enable_autosave(const std::string &path) {
+        // a previous log folds its changes first, in case it's the same file
+        autosave_.reset();
+        auto autosave = AutosaveLog::open(path);
+        if (!autosave) {
+            return false;
+        }
+
+        // restored before autosave_ is set, so the restore isn't logged again
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            auto &section = section_at(i);
+            if (auto *lazy = find_lazy(get_section_handle(i)); lazy && !lazy->resident) {
+                if (!autosave->covers(section.name)) {
+                    continue;
+                }
+                load_lazy_section(*lazy);
+            }
+            batch_section(i, [&](SectionT &target) { autosave->restore(target); });
+        }
+        autosave_ = std::move(autosave);
+        needs_redraw_ = true;
+        return true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::run() {
+        if (sections_.empty()) {
+            std::cout << "No sections available. Please add sections before running." << std::endl;
+            return;
+        }
+
+        if (!config_.autosave_path.empty() && !autosave_) {
+            // without the log the session still runs, it just isn't saved
+            enable_autosave(config_.autosave_path);
+        }
+
+        if (config_.run_mode == RunMode::headless ||
+            (config_.run_mode == RunMode::automatic && !TerminalUtils::has_terminal())) {
+            run_headless();
+            return;
+        }
+
+        if (!apply_configured_commands()) {
+            std::cerr << command_problem_ << std::endl;
+        }
+
+        initialize();
+        running_ = true;
+
+        while (running_) {
+            render();
+            process_events();
+
+            // FIXME: is there any fix to way this out?
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        terminal_manager_->restore_terminal();
+        finish_run();
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::run_headless() {
+        // commands may name items that async producers are still delivering
+        const auto timeout = config_.headless_load_timeout;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!loading_sections_.empty()) {
+            if (timeout.count() > 0 && std::chrono::steady_clock::now() >= deadline) {
+                std::string names;
+                for (const auto handle : loading_sections_) {
+                    if (const SectionT *section = get_section(handle)) {
+                        names += std::format("{}'{}'", names.empty() ? "" : ", ", section->name);
+                    }
+                }
+                command_problem_ = std::format("still loading after {} ms: {}", timeout.count(), names);
+                std::cerr << command_problem_ << std::endl;
+                disable_autosave();
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            drain_item_feed();
+        }
+
+        if (!apply_configured_commands()) {
+            std::cerr << command_problem_ << std::endl;
+            disable_autosave();
+            return;
+        }
+        finish_run();
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::finish_run() {
+        disable_autosave();
+
+        if (on_exit_) {
+            load_lazy_selections();
+            compact_sections();
+            on_exit_(sections_);
+        }
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::apply_configured_commands() {
+        if (!config_.selection_script.empty() && !apply_selection_script(config_.selection_script)) {
+            return false;
+        }
+        return apply_selection_commands(config_.selection_commands);
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::apply_selection_script(const std::string &path) {
+        std::ifstream file(path);
+        if (!file) {
+            command_problem_ = std::format("can't read selection script '{}'", path);
+            return false;
+        }
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(std::move(line));
+        }
+        return apply_selection_commands(lines);
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::apply_selection_commands(const std::span<const std::string> commands) {
+        command_problem_.clear();
+        // item names of each section touched so far, by display index
+        std::unordered_map<size_t, std::unordered_map<std::string_view, size_t>> item_indices;
+
+        for (const auto &entry : commands) {
+            std::string_view command = entry;
+            const auto first = command.find_first_not_of(" \t\r");
+            command = first == std::string_view::npos ? std::string_view{} : command.substr(first);
+            command = command.substr(0, command.find_last_not_of(" \t\r") + 1);
+            if (command.empty() || command.front() == '#') {
+                continue;
+            }
+
+            if (command.front() == '@') {
+                if (!restore_snapshot(std::string(command.substr(1)))) {
+                    command_problem_ = std::format("'{}': can't read the snapshot", command);
+                    return false;
+                }
+                continue;
+            }
+
+            bool selected = true;
+            if (command.front() == '+' || command.front() == '-') {
+                selected = command.front() == '+';
+                command.remove_prefix(1);
+            }
+
+            // the longest section name followed by '/' wins
+            std::optional<size_t> section_index;
+            for (size_t i = 0; i < sections_.size(); ++i) {
+                const std::string &name = section_at(i).name;
+                if (command.size() > name.size() && command.starts_with(name) && command[name.size()] == '/' &&
+                    (!section_index || name.size() > section_at(*section_index).name.size())) {
+                    section_index = i;
+                }
+            }
+            if (!section_index) {
+                command_problem_ = std::format("'{}': no such section", entry);
+                return false;
+            }
+            if (auto *lazy = find_lazy(get_section_handle(*section_index)); lazy && !lazy->resident) {
+                load_lazy_section(*lazy);
+            }
+
+            const auto &section = section_at(*section_index);
+            const std::string_view item = command.substr(section.name.size() + 1);
+            if (item == "*") {
+                batch_section(*section_index, [&](SectionT &target) {
+                    selected ? target.select_all() : target.clear_selections();
+                });
+                continue;
+            }
+
+            auto &indices = item_indices[*section_index];
+            if (indices.empty()) {
+                for (size_t index = 0; index < section.size(); ++index) {
+                    indices.emplace(section.item_name(index), index);
+                }
+            }
+            const auto it = indices.find(item);
+            if (it == indices.end()) {
+                command_problem_ = std::format("'{}': no such item", entry);
+                return false;
+            }
+            batch_section(*section_index,
+                          [&](SectionT &target) { target.set_item_selected(it->second, selected); });
+            if (section.is_item_selected(it->second) != selected) {
+                command_problem_ = std::format("'{}': not allowed by the section's constraints", entry);
+                return false;
+            }
+        }
+
+        needs_redraw_ = true;
+        return true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::exit() {
+        running_ = false;
+        std::cin.clear();
+    }
+
+    template <typename SectionT>
+    typename BasicNavigationTUI<SectionT>::NavigationState BasicNavigationTUI<SectionT>::get_current_state() const {
+        return current_state_;
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::get_current_section_index() const { return current_section_index_; }
+
+    template <typename SectionT>
+    int BasicNavigationTUI<SectionT>::get_current_page() const { return current_page_; }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::get_current_selection_index() const { return current_selection_index_; }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::return_to_sections() {
+        if (current_state_ != NavigationState::MAIN_MENU) {
+            change_state(NavigationState::MAIN_MENU);
+            current_selection_index_ = current_section_index_;
+            current_page_ = 0;
+            needs_redraw_ = true;
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::enter_section(const size_t section_index) {
+        if (section_index < sections_.size()) {
+            current_section_index_ = section_index;
+            current_selection_index_ = 0;
+            current_page_ = 0;
+
+            if (auto *lazy = find_lazy(get_section_handle(section_index))) {
+                lazy->last_used = ++lazy_clock_;
+                if (!lazy->resident) {
+                    load_lazy_section(*lazy);
+                }
+            }
+
+            change_state(NavigationState::ITEM_SELECTION);
+            evict_lazy_sections();
+
+            const auto &section = section_at(section_index);
+            section.trigger_enter();
+
+            if (on_section_selected_) {
+                on_section_selected_(section_index, section);
+            }
+
+            needs_redraw_ = true;
+        }
+    }
+
+    template <typename SectionT>
+    int BasicNavigationTUI<SectionT>::get_sections_on_current_page() const {
+        const int start = current_section_page_ * config_.layout.sections_per_page;
+        const int end = std::min(start + config_.layout.sections_per_page, static_cast<int>(sections_.size()));
+        return end - start;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::go_to_section_page(const int page) {
+        if (const int total_pages = calculate_total_pages();
+            page >= 0 && page < total_pages && page != current_section_page_) {
+            current_section_page_ = page;
+            current_selection_index_ = 0;
+            needs_redraw_ = true;
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::go_to_page(const int page) {
+        if (const int total_pages = calculate_total_pages(); page >= 0 && page < total_pages && page != current_page_) {
+            current_page_ = page;
+            current_selection_index_ = 0;
+
+            if (on_page_changed_) {
+                on_page_changed_(page, total_pages);
+            }
+
+            needs_redraw_ = true;
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::next_page() {
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            go_to_section_page(current_section_page_ + 1);
+        } else if (current_state_ == NavigationState::ITEM_SELECTION) {
+            go_to_page(current_page_ + 1);
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::previous_page() {
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            go_to_section_page(current_section_page_ - 1);
+        } else if (current_state_ == NavigationState::ITEM_SELECTION) {
+            go_to_page(current_page_ - 1);
+        }
+    }
+
+    template <typename SectionT>
+    std::map<std::string, std::vector<std::string>> BasicNavigationTUI<SectionT>::get_all_selections() const {
+        std::map<std::string, std::vector<std::string>> selections;
+
+        for (size_t storage_index = 0; storage_index < sections_.size(); ++storage_index) {
+            if (auto selected_items = selected_names(storage_index); !selected_items.empty()) {
+                selections[sections_[storage_index].name] = selected_items;
+            }
+        }
+
+        return selections;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::export_selections(const int fd, const ExportFormat format) const {
+        SelectionExporter exporter(fd, format);
+        for (size_t i = 0; i < sections_.size() && !exporter.failed(); ++i) {
+            const auto &section = section_at(i);
+            if (const auto *lazy = find_lazy(get_section_handle(i)); lazy && !lazy->resident) {
+                // unloaded: only the loader knows the names
+                for (const auto &name : selected_names(storage_index_at(i))) {
+                    exporter.add(section.name, name);
+                }
+                continue;
+            }
+            exporter.add(section);
+        }
+        return exporter.finish();
+    }
+
+    template <typename SectionT>
+    std::vector<std::string> BasicNavigationTUI<SectionT>::get_section_selections(const size_t section_index) const {
+        return (section_index < sections_.size()) ? selected_names(storage_index_at(section_index))
+                                                  : std::vector<std::string>{};
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::clear_all_selections() {
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            batch_section(i, [](SectionT &section) { section.clear_selections(); });
+        }
+        for (auto &lazy : lazy_sections_) {
+            lazy.selected_hashes.clear();
+            lazy.selected_count = 0;
+        }
+        page_cache_.clear();
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::clear_section_selections(const size_t section_index) {
+        if (section_index < sections_.size()) {
+            batch_section(section_index, [](SectionT &section) { section.clear_selections(); });
+            if (auto *lazy = find_lazy(get_section_handle(section_index))) {
+                lazy->selected_hashes.clear();
+                lazy->selected_count = 0;
+                page_cache_.clear();
+            }
+            needs_redraw_ = true;
+        }
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::select_where(const ItemPredicate &predicate, const bool selected) {
+        size_t changed = 0;
+        std::vector<ItemRef> matches = collect_where(predicate);
+        for (auto it = matches.begin(); it != matches.end();) {
+            const size_t section_index = it->section_index;
+            const auto end = std::ranges::find_if(
+                it, matches.end(), [&](const ItemRef &match) { return match.section_index != section_index; });
+            batch_section(section_index, [&](SectionT &section) {
+                for (auto match = it; match != end; ++match) {
+                    changed += section.set_item_selected(match->item_index, selected) ? 1 : 0;
+                }
+            });
+            it = end;
+        }
+
+        if (changed > 0) {
+            needs_redraw_ = true;
+        }
+        return changed;
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::count_where(const ItemPredicate &predicate) const {
+        std::atomic<size_t> total{0};
+        scan_items([&](size_t, const size_t section_index, const size_t first, const size_t last) {
+            const auto &section = section_at(section_index);
+            size_t count = 0;
+            for (size_t index = first; index < last; ++index) {
+                count += predicate(section, index) ? 1 : 0;
+            }
+            total.fetch_add(count, std::memory_order_relaxed);
+        });
+        return total.load();
+    }
+
+    template <typename SectionT>
+    std::vector<typename BasicNavigationTUI<SectionT>::ItemRef> BasicNavigationTUI<SectionT>::collect_where(
+        const ItemPredicate &predicate) const {
+        // chunks are disjoint and ordered, so sorted per-chunk results concatenate in item order
+        std::vector<std::vector<ItemRef>> found;
+        std::mutex found_mutex;
+        const size_t chunks = scan_items([&](const size_t chunk, const size_t section_index, const size_t first,
+                                             const size_t last) {
+            const auto &section = section_at(section_index);
+            std::vector<ItemRef> local;
+            for (size_t index = first; index < last; ++index) {
+                if (predicate(section, index)) {
+                    local.push_back({section_index, index});
+                }
+            }
+            if (!local.empty()) {
+                std::lock_guard lock(found_mutex);
+                if (found.size() <= chunk) {
+                    found.resize(chunk + 1);
+                }
+                auto &slot = found[chunk];
+                slot.insert(slot.end(), local.begin(), local.end());
+            }
+        });
+
+        std::vector<ItemRef> result;
+        for (size_t chunk = 0; chunk < std::min(chunks, found.size()); ++chunk) {
+            // a chunk spanning a serially scanned source is filled in two goes
+            std::ranges::sort(found[chunk], {}, [](const ItemRef &ref) {
+                return std::pair(ref.section_index, ref.item_index);
+            });
+            result.insert(result.end(), found[chunk].begin(), found[chunk].end());
+        }
+        return result;
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::scan_items(
+        const std::function<void(size_t chunk, size_t section_index, size_t first, size_t last)> &fn) const {
+        // large enough to amortize the claim, small enough to balance regexes of uneven cost
+        constexpr size_t grain = 4096;
+
+        std::vector<size_t> offsets; ///< Global index of each section's first item, plus the total
+        offsets.reserve(sections_.size() + 1);
+        size_t total = 0;
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            offsets.push_back(total);
+            total += section_at(i).size();
+        }
+        offsets.push_back(total);
+
+        // a source may hand out views that its next read invalidates, and const accessors
+        // refresh lazy state on first use, so that is done here before the workers share it
+        std::vector<bool> serial(sections_.size());
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            const auto &section = section_at(i);
+            section.prepare_reads();
+            serial[i] = section.has_source() && !section.source()->concurrent_reads();
+        }
+
+        struct Piece {
+            size_t chunk, section, first, last;
+        };
+        std::vector<Piece> deferred;
+        std::mutex deferred_mutex;
+
+        ThreadPool::shared().parallel_for(total, grain, [&](const size_t begin, const size_t end) {
+            const size_t chunk = begin / grain;
+            auto section = static_cast<size_t>(std::ranges::upper_bound(offsets, begin) - offsets.begin()) - 1;
+            for (size_t position = begin; position < end; ++section) {
+                const size_t last = std::min(end, offsets[section + 1]);
+                if (last > position && serial[section]) {
+                    std::lock_guard lock(deferred_mutex);
+                    deferred.push_back({chunk, section, position - offsets[section], last - offsets[section]});
+                } else if (last > position) {
+                    fn(chunk, section, position - offsets[section], last - offsets[section]);
+                }
+                position = last;
+            }
+        });
+
+        for (const auto &[chunk, section, first, last] : deferred) {
+            fn(chunk, section, first, last);
+        }
+        return (total + grain - 1) / grain;
+    }
+
+    template <typename SectionT>
+    std::vector<typename BasicNavigationTUI<SectionT>::ItemRef> BasicNavigationTUI<SectionT>::search_items(
+        const std::string_view query, const size_t limit) const {
+        std::vector<ItemRef> hits;
+        if (query.size() < TrigramIndex::min_query_length || limit == 0) {
+            return hits;
+        }
+
+        std::vector<std::pair<SectionHandle, size_t>> display_index(sections_.size());
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            display_index[i] = {get_section_handle(i), i};
+        }
+        std::ranges::sort(display_index, {}, [](const auto &entry) { return entry.first.slot; });
+
+        // the index may be a little behind: verify every candidate against the live section
+        for (const auto &[handle, item] : search_index_.candidates(query, limit * 4)) {
+            const auto it = std::ranges::lower_bound(display_index, handle.slot, {},
+                                                     [](const auto &entry) { return entry.first.slot; });
+            if (it == display_index.end() || it->first != handle) {
+                continue;
+            }
+            const auto &section = section_at(it->second);
+            if (item >= section.size() || !section.is_item_ready(item)) {
+                continue;
+            }
+            if (std::ranges::search(section.item_name(item), query, detail::folded_equal).empty()) {
+                continue;
+            }
+            hits.push_back({it->second, item});
+            if (hits.size() == limit) {
+                break;
+            }
+        }
+
+        std::ranges::sort(hits, [this](const ItemRef &a, const ItemRef &b) {
+            if (a.section_index != b.section_index) {
+                return a.section_index < b.section_index;
+            }
+            const auto &section = section_at(a.section_index);
+            return section.position_of(a.item_index) < section.position_of(b.item_index);
+        });
+        return hits;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::jump_to_item(const ItemRef &item) {
+        if (item.section_index >= sections_.size()) {
+            return false;
+        }
+
+        enter_section(item.section_index);
+        const auto &section = section_at(item.section_index);
+        if (item.item_index >= section.size()) {
+            return false;
+        }
+
+        move_cursor_to(section.position_of(item.item_index));
+        return true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::update_config(const Config &new_config) {
+        config_ = new_config;
+        page_cache_.clear();
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::update_theme(const Theme &new_theme) {
+        config_.theme = new_theme;
+        page_cache_.clear();
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::update_layout(const Layout &new_layout) {
+        config_.layout = new_layout;
+        page_cache_.clear();
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::update_text_config(const TextConfig &new_text_config) {
+        config_.text = new_text_config;
+        page_cache_.clear();
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    const typename BasicNavigationTUI<SectionT>::Config &BasicNavigationTUI<SectionT>::get_config() const {
+        return config_;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::initialize() {
+        terminal_manager_->setup_terminal();
+        validate_indices();
+
+        auto [t_height, t_width] = TerminalManager::get_terminal_size();
+        previous_width_ = t_width;
+        previous_height_ = t_height;
+
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::process_events() {
+        drain_item_feed();
+        apply_file_reloads();
+        animate_loading();
+        refresh_loaded_rows();
+
+        if (!number_buffer_.empty() && std::chrono::steady_clock::now() - last_digit_ >= type_ahead_timeout) {
+            apply_number_input();
+        }
+
+        if (auto [t_height, t_width] = TerminalManager::get_terminal_size();
+            t_width != previous_width_ || t_height != previous_height_) {
+            previous_width_ = t_width;
+            previous_height_ = t_height;
+            needs_redraw_ = true;
+        }
+
+        if (const auto key_event = TerminalManager::get_key_input(); key_event.has_value()) {
+            handle_input(key_event->key, key_event->character);
+        } else {
+            prerender_adjacent_pages();
+            sync_search_index();
+        }
+    }
+
+    template <typename SectionT>
+    std::shared_ptr<ItemFeed> BasicNavigationTUI<SectionT>::get_item_feed() const { return item_feed_; }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::stream_section(const size_t section_index, const int fd) {
+        if (section_index >= sections_.size()) {
+            return false;
+        }
+        const SectionHandle handle = get_section_handle(section_index);
+        loading_sections_.push_back(handle);
+        producers_.push_back(stream_lines(fd, item_feed_, handle));
+        return true;
+    }
+
+    template <typename SectionT>
+    SectionHandle BasicNavigationTUI<SectionT>::add_async_section(SectionT section, SectionProvider provider) {
+        add_section(std::move(section));
+        const SectionHandle handle = section_handles_.back();
+        loading_sections_.push_back(handle);
+        producers_.push_back(run_provider(std::move(provider), item_feed_, handle));
+        needs_redraw_ = true;
+        return handle;
+    }
+
+    template <typename SectionT>
+    SectionHandle BasicNavigationTUI<SectionT>::add_async_section(SectionT section,
+                                                                  std::future<std::vector<item_type>> items) {
+        auto future = std::make_shared<std::future<std::vector<item_type>>>(std::move(items));
+        return add_async_section(std::move(section), [future](ItemSink &sink) {
+            while (future->wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+                if (sink.stop_requested()) {
+                    return;
+                }
+            }
+            sink.push(detail::erase_items(future->get()));
+        });
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::is_section_loading(const size_t section_index) const {
+        return section_index < sections_.size() &&
+            std::ranges::find(loading_sections_, get_section_handle(section_index)) != loading_sections_.end();
+    }
+
+    template <typename SectionT>
+    SectionHandle BasicNavigationTUI<SectionT>::add_lazy_section(SectionT section, SectionLoader loader) {
+        add_section(std::move(section));
+        const SectionHandle handle = section_handles_.back();
+        LazySection lazy;
+        lazy.handle = handle;
+        lazy.loader = std::move(loader);
+        lazy_sections_.push_back(std::move(lazy));
+        return handle;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::is_section_resident(const size_t section_index) const {
+        const auto *lazy = find_lazy(get_section_handle(section_index));
+        return section_index < sections_.size() && (!lazy || lazy->resident);
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::get_resident_lazy_bytes() const {
+        size_t bytes = 0;
+        for (const auto &lazy : lazy_sections_) {
+            bytes += lazy.resident ? lazy.bytes : 0;
+        }
+        return bytes;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::drain_item_feed() {
+        // appending in larger steps keeps redraws down while a producer is busy
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_feed_drain_ < std::chrono::milliseconds(50) || item_feed_->empty()) {
+            return;
+        }
+        last_feed_drain_ = now;
+
+        const int old_total_pages = calculate_total_pages();
+        const auto [old_first, old_second] = get_current_page_bounds();
+
+        for (auto &[handle, items, done] : item_feed_->drain()) {
+            auto *section = get_section(handle);
+            if (done) {
+                std::erase(loading_sections_, handle);
+                if (section && section == get_section(current_section_index_)) {
+                    // the empty-section placeholder changes from spinner to message
+                    needs_redraw_ = needs_redraw_ || section->empty();
+                }
+            }
+            if (!section) {
+                continue;
+            }
+            // revisions tell cached rows, the search index and type-ahead to catch up
+            if (!items.empty() && !section->has_source()) {
+                const size_t first = section->size();
+                section->add_items(detail::adopt_items<item_type>(std::move(items)));
+                if (const auto index = get_section_index(handle)) {
+                    restore_autosaved(*index, first);
+                }
+            } else if (done) {
+                section->touch(); // the spinner goes away
+            } else {
+                continue;
+            }
+
+            if (current_state_ == NavigationState::MAIN_MENU) {
+                if (const auto index = get_section_index(handle)) {
+                    invalidate_row(*index);
+                }
+            }
+        }
+
+        if (current_state_ == NavigationState::ITEM_SELECTION) {
+            if (const auto [first, second] = get_current_page_bounds();
+                second - first != old_second - old_first || calculate_total_pages() != old_total_pages) {
+                needs_redraw_ = true;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::animate_loading() {
+        if (loading_sections_.empty()) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_spinner_tick_ < std::chrono::milliseconds(100)) {
+            return;
+        }
+        last_spinner_tick_ = now;
+        ++spinner_frame_;
+
+        for (const auto handle : loading_sections_) {
+            const auto index = get_section_index(handle);
+            if (!index) {
+                continue;
+            }
+            if (current_state_ == NavigationState::MAIN_MENU) {
+                invalidate_row(*index);
+            } else if (*index == current_section_index_ && section_at(*index).empty()) {
+                invalidate_row(0);
+            }
+        }
+    }
+
+    template <typename SectionT>
+    std::string_view BasicNavigationTUI<SectionT>::spinner_glyph() const {
+        static constexpr std::string_view unicode_frames[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
+        static constexpr std::string_view ascii_frames[] = {"|", "/", "-", "\\"};
+        return config_.theme.use_unicode ? unicode_frames[spinner_frame_ % std::size(unicode_frames)]
+                                         : ascii_frames[spinner_frame_ % std::size(ascii_frames)];
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::handle_input(const TerminalUtils::Key key, const char character) {
+        // The search prompt takes every key while it is open
+        if (search_active_) {
+            handle_search_input(key, character);
+            return;
+        }
+        if (goto_active_) {
+            handle_goto_input(key, character);
+            return;
+        }
+
+        // Digits typed for a quick jump can be corrected before the jump fires
+        if (key == TerminalUtils::Key::BACKSPACE && !number_buffer_.empty()) {
+            number_buffer_.pop_back();
+            last_digit_ = std::chrono::steady_clock::now();
+            needs_redraw_ = true;
+            return;
+        }
+
+        // With type-ahead on, item lists give lowercase letters to it, 'q' included
+        if (handle_type_ahead(character)) {
+            return;
+        }
+
+        // Handle global commands first
+        if (std::tolower(character) == 'q') {
+            exit();
+            return;
+        }
+
+        // Custom keybindings
+        if (on_custom_command_ && on_custom_command_(character, current_state_)) {
+            // the command may have edited items without going through Section
+            page_cache_.clear();
+            return;
+        }
+
+        if (character == ':') {
+            goto_active_ = true;
+            goto_query_.clear();
+            number_buffer_.clear();
+            needs_redraw_ = true;
+            return;
+        }
+
+        if (character == '/') {
+            search_active_ = true;
+            search_query_.clear();
+            update_search();
+            needs_redraw_ = true;
+            return;
+        }
+
+        if (std::tolower(character) == 'u') {
+            undo();
+            return;
+        }
+        if (std::tolower(character) == 'r') {
+            redo();
+            return;
+        }
+
+        // Handle state-specific input
+        handle_item_input(key, character);
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::handle_item_input(const TerminalUtils::Key key, const char character) {
+        switch (key) {
+        case TerminalUtils::Key::ESCAPE:
+            return_to_sections();
+            break;
+
+        case TerminalUtils::Key::ARROW_UP:
+            move_selection_up();
+            break;
+
+        case TerminalUtils::Key::ARROW_DOWN:
+            move_selection_down();
+            break;
+
+        case TerminalUtils::Key::ARROW_LEFT:
+            previous_page();
+            break;
+
+        case TerminalUtils::Key::ARROW_RIGHT:
+            next_page();
+            break;
+
+        case TerminalUtils::Key::SPACE:
+            toggle_current_item();
+            break;
+
+        case TerminalUtils::Key::ENTER:
+            if (current_state_ == NavigationState::ITEM_SELECTION) {
+                return_to_sections();
+            } else if (current_state_ == NavigationState::MAIN_MENU) {
+                select_current_item();
+            }
+            break;
+
+        case TerminalUtils::Key::NORMAL:
+            // uppercase works too, for when type-ahead has the lowercase letters
+            if (current_state_ == NavigationState::ITEM_SELECTION) {
+                if (std::tolower(character) == 'b') {
+                    return_to_sections();
+                } else if (std::tolower(character) == 'a') {
+                    if (current_section_index_ < sections_.size()) {
+                        batch_section(current_section_index_, [](SectionT &section) { section.select_all(); });
+                        needs_redraw_ = true;
+                    }
+                } else if (std::tolower(character) == 'n') {
+                    if (current_section_index_ < sections_.size()) {
+                        batch_section(current_section_index_, [](SectionT &section) { section.clear_selections(); });
+                        needs_redraw_ = true;
+                    }
+                } else if (std::isdigit(character)) {
+                    handle_number_input(character);
+                }
+            } else if (current_state_ == NavigationState::MAIN_MENU && std::isdigit(character)) {
+                handle_number_input(character);
+            }
+            break;
+
+        default:
+            if (config_.enable_vim_keys) {
+                if (character == 'j') {
+                    move_selection_down();
+                } else if (character == 'k') {
+                    move_selection_up();
+                } else if (character == 'h') {
+                    return_to_sections();
+                }
+            }
+            break;
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::move_selection_up() {
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            if (current_selection_index_ > 0) {
+                current_selection_index_--;
+            } else if (current_section_page_ > 0) {
+                go_to_section_page(current_section_page_ - 1);
+                current_selection_index_ = get_sections_on_current_page() - 1;
+            }
+        } else {
+            if (current_selection_index_ > 0) {
+                current_selection_index_--;
+            } else {
+                if (current_page_ > 0) {
+                    go_to_page(current_page_ - 1);
+                    auto [first, second] = get_current_page_bounds();
+                    current_selection_index_ = second - first - 1;
+                }
+            }
+        }
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::move_selection_down() {
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            if (const int items_on_page = get_sections_on_current_page();
+                static_cast<int>(current_selection_index_) < items_on_page - 1) {
+                current_selection_index_++;
+            } else if (current_section_page_ < calculate_total_pages() - 1) {
+                go_to_section_page(current_section_page_ + 1);
+                current_selection_index_ = 0;
+            }
+        } else {
+            auto [first, second] = get_current_page_bounds();
+
+            if (const size_t items_on_page = second - first; current_selection_index_ < items_on_page - 1) {
+                current_selection_index_++;
+            } else {
+                if (const int total_pages = calculate_total_pages(); current_page_ < total_pages - 1) {
+                    go_to_page(current_page_ + 1);
+                    current_selection_index_ = 0;
+                }
+            }
+        }
+
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::select_current_item() {
+        if (current_state_ == NavigationState::MAIN_MENU && current_selection_index_ < sections_.size()) {
+            enter_section(current_selection_index_);
+        } else {
+            toggle_current_item();
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::toggle_current_item() {
+        if (current_state_ == NavigationState::ITEM_SELECTION && current_section_index_ < sections_.size()) {
+            auto [start, end] = get_current_page_bounds();
+
+            const size_t global_index = start + current_selection_index_;
+            bool toggled = false;
+
+            batch_section(current_section_index_,
+                          [&](SectionT &section) { toggled = section.toggle_item(section.index_at(global_index)); });
+
+            if (toggled) {
+                needs_redraw_ = true;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::handle_number_input(const char digit) {
+        if (!config_.enable_quick_select) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_digit_ >= type_ahead_timeout) {
+            number_buffer_.clear();
+        }
+        last_digit_ = now;
+        number_buffer_ += digit;
+
+        // act right away unless another digit could still name a valid target
+        const size_t number = std::stoull(number_buffer_);
+        // section pages are reached through the ':' prompt, digits on the main menu name sections
+        const size_t limit = (current_state_ == NavigationState::MAIN_MENU)
+            ? sections_.size()
+            : static_cast<size_t>(calculate_total_pages());
+        if (number_buffer_.size() >= 9 || number * 10 > limit) {
+            apply_number_input();
+        } else {
+            needs_redraw_ = true; // shows the pending number in the footer
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::apply_number_input() {
+        const size_t number = number_buffer_.empty() ? 0 : std::stoull(number_buffer_);
+        number_buffer_.clear();
+        needs_redraw_ = true;
+        if (number == 0) {
+            return;
+        }
+
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            if (number <= sections_.size()) {
+                const size_t global_index = number - 1;
+                const auto per_page = static_cast<size_t>(config_.layout.sections_per_page);
+
+                current_section_page_ = static_cast<int>(global_index / per_page);
+                current_selection_index_ = global_index % per_page;
+
+                enter_section(global_index);
+            }
+        } else if (current_state_ == NavigationState::ITEM_SELECTION) {
+            go_to_page(static_cast<int>(number) - 1);
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::handle_goto_input(const TerminalUtils::Key key, const char character) {
+        switch (key) {
+        case TerminalUtils::Key::ESCAPE:
+            goto_active_ = false;
+            break;
+
+        case TerminalUtils::Key::ENTER:
+            goto_active_ = false;
+            go_to(goto_query_);
+            break;
+
+        case TerminalUtils::Key::BACKSPACE:
+            if (!goto_query_.empty()) {
+                goto_query_.pop_back();
+            }
+            break;
+
+        default:
+            if (std::isdigit(character) || (goto_query_.empty() && std::tolower(character) == 'p')) {
+                goto_query_ += character;
+            }
+            break;
+        }
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::go_to(std::string_view target) {
+        const bool page = !target.empty() && std::tolower(target.front()) == 'p';
+        if (page) {
+            target.remove_prefix(1);
+        }
+
+        size_t number = 0;
+        if (const auto [end, error] = std::from_chars(target.data(), target.data() + target.size(), number);
+            error != std::errc() || end != target.data() + target.size() || number == 0) {
+            return;
+        }
+
+        // pages and offsets follow from the number directly, however long the list
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            const auto per_page = static_cast<size_t>(config_.layout.sections_per_page);
+            if (page) {
+                go_to_section_page(static_cast<int>(std::min<size_t>(number, INT_MAX)) - 1);
+            } else if (number <= sections_.size()) {
+                go_to_section_page(static_cast<int>((number - 1) / per_page));
+                current_selection_index_ = (number - 1) % per_page;
+                needs_redraw_ = true;
+            }
+        } else if (current_section_index_ < sections_.size()) {
+            if (page) {
+                go_to_page(static_cast<int>(std::min<size_t>(number, INT_MAX)) - 1);
+            } else if (number <= section_at(current_section_index_).size()) {
+                move_cursor_to(number - 1);
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::move_cursor_to(const size_t position) {
+        const auto per_page = static_cast<size_t>(config_.layout.items_per_page);
+        go_to_page(static_cast<int>(position / per_page));
+        current_selection_index_ = position % per_page;
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::is_type_ahead_pending() const {
+        return config_.enable_type_ahead && current_state_ == NavigationState::ITEM_SELECTION &&
+            !type_ahead_prefix_.empty() && std::chrono::steady_clock::now() - last_type_ahead_ < type_ahead_timeout;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::handle_type_ahead(const char character) {
+        if (!config_.enable_type_ahead || current_state_ != NavigationState::ITEM_SELECTION ||
+            current_section_index_ >= sections_.size() || !std::isgraph(static_cast<unsigned char>(character))) {
+            return false;
+        }
+
+        if (!is_type_ahead_pending()) {
+            // lowercase command keys move to their uppercase form; names match case-insensitively anyway
+            if (std::string_view("ABNQRU/:").contains(character) || std::isdigit(character) ||
+                config_.custom_shortcuts.contains(character)) {
+                return false;
+            }
+            type_ahead_prefix_.clear();
+        }
+        type_ahead_prefix_ += character;
+        last_type_ahead_ = std::chrono::steady_clock::now();
+
+        if (const auto position = find_prefix(section_at(current_section_index_), type_ahead_prefix_)) {
+            move_cursor_to(*position);
+        }
+        return true;
+    }
+
+    template <typename SectionT>
+    std::optional<size_t> BasicNavigationTUI<SectionT>::find_prefix(const SectionT &section,
+                                                                    const std::string_view prefix) {
+        const SectionHandle handle = get_section_handle(current_section_index_);
+        const uint64_t revision = section.content_revision();
+
+        auto it = std::ranges::find(prefix_indexes_, handle, &PrefixIndex::section);
+        if (it == prefix_indexes_.end() || it->revision != revision) {
+            // rows of a slow source would all be fetched just to sort them
+            for (size_t index = 0; index < section.size(); ++index) {
+                if (!section.is_item_ready(index)) {
+                    return std::nullopt;
+                }
+            }
+
+            if (it == prefix_indexes_.end()) {
+                if (prefix_indexes_.size() >= max_prefix_indexes) {
+                    prefix_indexes_.erase(prefix_indexes_.begin());
+                }
+                it = prefix_indexes_.insert(prefix_indexes_.end(), {handle, revision, {}});
+            }
+            it->revision = revision;
+            it->indices.resize(section.size());
+            std::iota(it->indices.begin(), it->indices.end(), uint32_t{0});
+            std::ranges::stable_sort(it->indices, detail::folded_less,
+                                     [&](const uint32_t index) { return section.item_name(index); });
+        }
+
+        const auto name_at = [&](const uint32_t index) { return section.item_name(index); };
+        const auto first = std::ranges::lower_bound(it->indices, prefix, detail::folded_less, name_at);
+        if (first == it->indices.end()) {
+            return std::nullopt;
+        }
+        const std::string_view name = name_at(*first);
+        if (name.size() < prefix.size() ||
+            !std::ranges::equal(name.substr(0, prefix.size()), prefix, detail::folded_equal)) {
+            return std::nullopt;
+        }
+        return section.position_of(*first);
+    }
+
+    template <typename SectionT>
+    int BasicNavigationTUI<SectionT>::get_effective_content_width(const int term_width) const {
+        int content_width = term_width - 4;
+
+        if (config_.layout.show_borders) {
+            content_width -= 2;
+        }
+
+        content_width = (config_.layout.auto_resize_content)
+            ? std::clamp(content_width, config_.layout.min_content_width, config_.layout.max_content_width)
+            : config_.layout.max_content_width;
+
+        return content_width;
+    }
+
+    template <typename SectionT>
+    int BasicNavigationTUI<SectionT>::get_effective_content_height() const {
+        auto content_height = 0;
+
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            content_height = 3 + static_cast<int>(sections_.size()) + 2;
+        } else if (current_section_index_ < sections_.size()) {
+            auto [first, second] = get_current_page_bounds();
+            content_height = 3 + static_cast<int>((second - first)) + 2;
+        }
+
+        content_height += 2 * config_.layout.vertical_padding;
+
+        if (config_.layout.show_borders) {
+            content_height += 2;
+        }
+
+        return content_height;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::draw_border(int top, int left, int width, int height) const {
+        std::string top_left, top_right, bottom_left, bottom_right, horizontal, vertical;
+
+        switch (config_.theme.border_style) {
+        case tui_extras::BorderStyle::ROUNDED:
+            top_left = "╭";
+            top_right = "╮";
+            bottom_left = "╰";
+            bottom_right = "╯";
+            horizontal = "─";
+            vertical = "│";
+            break;
+        case tui_extras::BorderStyle::DOUBLE:
+            top_left = "╔";
+            top_right = "╗";
+            bottom_left = "╚";
+            bottom_right = "╝";
+            horizontal = "═";
+            vertical = "║";
+            break;
+        case tui_extras::BorderStyle::SHARP:
+            top_left = "┌";
+            top_right = "┐";
+            bottom_left = "└";
+            bottom_right = "┘";
+            horizontal = "─";
+            vertical = "│";
+            break;
+        case tui_extras::BorderStyle::ASCII:
+        default:
+            top_left = "+";
+            top_right = "+";
+            bottom_left = "+";
+            bottom_right = "+";
+            horizontal = "-";
+            vertical = "|";
+            break;
+        }
+
+        TerminalUtils::move_cursor(top, left);
+        std::cout << top_left;
+        for (auto i = 0; i < width - 2; ++i) {
+            std::cout << horizontal;
+        }
+        std::cout << top_right;
+
+        for (int y = top + 1; y < top + height - 1; ++y) {
+            TerminalUtils::move_cursor(y, left);
+            std::cout << vertical;
+            TerminalUtils::move_cursor(y, left + width - 1);
+            std::cout << vertical;
+        }
+
+        TerminalUtils::move_cursor(top + height - 1, left);
+        std::cout << bottom_left;
+        for (int i = 0; i < width - 2; ++i) {
+            std::cout << horizontal;
+        }
+        std::cout << bottom_right;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render() {
+        if (!needs_redraw_) {
+            if (search_active_) {
+                dirty_rows_.clear(); // the rows are hidden behind the prompt; closing it redraws everything
+            } else if (!dirty_rows_.empty()) {
+                render_dirty_rows();
+            }
+            return;
+        }
+
+        TerminalManager::clear_screen();
+
+        auto [term_height, term_width] = TerminalManager::get_terminal_size();
+        int content_width = get_effective_content_width(term_width);
+        auto left_padding = 1;
+
+        if (config_.layout.center_horizontally) {
+            left_padding = (term_width - content_width) / 2;
+        }
+
+        auto start_row = 1;
+        if (config_.layout.center_vertically) {
+            const int content_height = get_effective_content_height();
+            start_row = std::max(1, (term_height - content_height) / 2);
+        }
+
+        if (config_.layout.show_borders) {
+            content_width = std::max(10, content_width - 2);
+
+            left_padding = std::max(1, left_padding - 1);
+            start_row = std::max(1, start_row - 1);
+        }
+
+        if (config_.layout.show_borders) {
+            auto content_height = 0;
+
+            if (search_active_) {
+                const size_t rows = std::min(search_hits_.size(), static_cast<size_t>(config_.layout.items_per_page));
+                content_height = 3 + 2 + static_cast<int>(std::max<size_t>(rows, 1)) + 2;
+            } else if (current_state_ == NavigationState::MAIN_MENU) {
+                content_height = 3 + static_cast<int>(sections_.size()) + 2;
+            } else if (current_section_index_ < sections_.size()) {
+                auto [first, second] = get_current_page_bounds();
+                content_height = 3 + static_cast<int>((second - first)) + 2;
+            }
+
+            content_height += 2 * config_.layout.vertical_padding;
+            draw_border(start_row, left_padding, content_width + 2, content_height + 2);
+
+            left_padding += 1;
+            start_row += 1;
+        }
+
+        start_row += config_.layout.vertical_padding;
+        row_layout_ = {start_row + 2 + config_.layout.vertical_padding, left_padding, content_width};
+
+        if (search_active_) {
+            render_search(start_row, left_padding, content_width);
+        } else if (current_state_ == NavigationState::MAIN_MENU) {
+            render_section_selection(start_row, left_padding, content_width);
+        } else {
+            render_item_selection(start_row, left_padding, content_width);
+        }
+
+        std::optional<std::string_view> current_description;
+        std::string provided;
+        awaiting_footer_ = false;
+        awaiting_description_ = false;
+        if (search_active_) {
+            if (search_cursor_ < search_hits_.size()) {
+                const auto &[section_index, item_index] = search_hits_[search_cursor_];
+                if (const auto &section = section_at(section_index); section.is_item_ready(item_index)) {
+                    current_description = section.item_description(item_index);
+                }
+            }
+        } else if (current_state_ == NavigationState::ITEM_SELECTION && current_section_index_ < sections_.size()) {
+            const auto &section = section_at(current_section_index_);
+
+            if (auto [first, second] = get_current_page_bounds(); current_selection_index_ < (second - first)) {
+                const size_t index = section.index_at(first + current_selection_index_);
+                if (!section.is_item_ready(index)) {
+                    current_description = config_.text.loading_message;
+                    awaiting_footer_ = true;
+                    awaiting_rows_ = true;
+                } else if (!description_provider_ || !section.item_description(index).empty()) {
+                    current_description = section.item_description(index);
+                } else if (auto text = provided_description(section, index)) {
+                    provided = std::move(*text);
+                    current_description = provided;
+                } else {
+                    current_description = config_.text.loading_message;
+                    awaiting_description_ = true;
+                }
+            }
+        }
+
+        render_footer(term_height, left_padding, content_width, current_description);
+        TerminalManager::flush_output();
+
+        needs_redraw_ = false;
+        dirty_rows_.clear();
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_header(int /*term_width*/, const int content_width,
+                                                     const std::string &title) {
+        const std::string centered_title = center_string(title, content_width).content;
+        const std::string separator = center_string(std::string(title.length(), '='), content_width).content;
+
+        std::cout << centered_title << "\n";
+        std::cout << separator << "\n\n";
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::apply_gradient_text(const std::string &text, const int row,
+                                                           const int col) const {
+        if (!config_.theme.gradient_enabled) {
+            return;
+        }
+
+        const auto steps = static_cast<int>(text.length());
+        if (steps == 0) {
+            return;
+        }
+
+        auto gradient = tui_extras::GradientColor::from_preset(config_.theme.gradient_preset, steps);
+
+        if (config_.theme.gradient_randomize) {
+            std::ranges::shuffle(gradient, std::mt19937(std::random_device()()));
+        }
+
+        TerminalUtils::move_cursor(row, col);
+
+        for (auto i = 0; i < steps; i++) {
+            TerminalUtils::set_color_rgb(gradient[i]);
+            std::cout << text[i];
+        }
+
+        TerminalUtils::reset_formatting();
+    }
+
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_section_selection(const int start_row, const int left_padding,
+                                                                const int content_width) {
+        // Header
+        TerminalUtils::move_cursor(start_row, left_padding);
+        std::cout << center_string(config_.text.section_selection_title, content_width).content;
+
+        TerminalUtils::move_cursor(start_row + 1, left_padding);
+        std::cout
+            << center_string(std::string(config_.text.section_selection_title.length(), '='), content_width).content;
+
+        // Sections
+        const auto start_index = current_section_page_ * config_.layout.sections_per_page;
+        const auto end_index =
+            std::min(start_index + config_.layout.sections_per_page, static_cast<int>(sections_.size()));
+        const auto items_on_page = end_index - start_index;
+        const int items_start_row = start_row + 2 + config_.layout.vertical_padding;
+
+        const auto &page = prerender_page(NavigationState::MAIN_MENU, current_section_page_, content_width);
+        for (auto i = 0; i < items_on_page; ++i) {
+            const size_t index = start_index + i;
+            if (i == static_cast<int>(current_selection_index_) || is_section_loading(index)) {
+                render_section_row(index, items_start_row + i, left_padding, content_width);
+            } else {
+                TerminalUtils::move_cursor(items_start_row + i, left_padding);
+                std::cout << page.rows[i];
+            }
+        }
+    }
+
+    template <typename SectionT>
+    std::string BasicNavigationTUI<SectionT>::section_row_text(const size_t index, const bool highlighted) const {
+        std::string display_text = std::format("{}. {}", index + 1, section_at(index).name);
+        if (config_.text.show_counters) {
+            if (const auto [selected_count, total_count] = section_counts(index); total_count > 0) {
+                display_text += " (" + std::to_string(selected_count) + "/" + std::to_string(total_count) + ")";
+            }
+        }
+        if (is_section_loading(index)) {
+            display_text += std::format(" {}", spinner_glyph());
+        }
+        std::string prefix = highlighted ? "> " : "  ";
+        return prefix + display_text;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_section_row(const size_t index, const int row, const int left_padding,
+                                                          const int content_width) {
+        const bool highlighted =
+            index == current_section_page_ * config_.layout.sections_per_page + current_selection_index_;
+        const std::string text = section_row_text(index, highlighted);
+
+        auto [t_content, t_line_count] = center_string(text, content_width);
+        const int centered_col = left_padding + (content_width - static_cast<int>(text.length())) / 2;
+
+        TerminalUtils::move_cursor(row, left_padding);
+
+        if (highlighted) {
+            if (config_.theme.gradient_enabled && config_.theme.gradient_preset != tui_extras::GradientPreset::NONE()) {
+                std::cout << t_content;
+
+                apply_gradient_text(text, row, centered_col);
+            } else if (config_.theme.use_colors) {
+                TerminalUtils::set_color(config_.theme.accent_color);
+                std::cout << t_content;
+                TerminalUtils::reset_formatting();
+            } else {
+                std::cout << t_content;
+            }
+        } else {
+            std::cout << t_content;
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_item_selection(const int start_row, const int left_padding,
+                                                             const int content_width) {
+        if (current_section_index_ >= sections_.size()) {
+            return;
+        }
+
+        const auto &section = section_at(current_section_index_);
+
+        // Header
+        const std::string title = config_.text.item_selection_prefix + section.name;
+        TerminalUtils::move_cursor(start_row, left_padding);
+        std::cout << center_string(title, content_width).content;
+
+        TerminalUtils::move_cursor(start_row + 1, left_padding);
+        std::cout << center_string(std::string(title.length(), '='), content_width).content;
+
+        const int items_start_row = start_row + 2 + config_.layout.vertical_padding;
+
+        // Items
+        if (section.empty()) {
+            render_empty_section(items_start_row, left_padding, content_width);
+            return;
+        }
+
+        auto [first, second] = get_current_page_bounds();
+        section.notify_view(first, second);
+
+        awaiting_rows_ = false;
+        awaiting_revision_ = section.revision();
+        const auto &page = prerender_page(NavigationState::ITEM_SELECTION, current_page_, content_width);
+        for (size_t i = first; i < second; ++i) {
+            awaiting_rows_ = awaiting_rows_ || !section.is_item_ready(section.index_at(i));
+            const auto row = static_cast<int>(items_start_row + (i - first));
+            if (i - first == current_selection_index_) {
+                render_item_row(section, i, row, left_padding, content_width);
+            } else {
+                TerminalUtils::move_cursor(row, left_padding);
+                std::cout << page.rows[i - first];
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_item_row(const SectionT &section, const size_t position, const int row,
+                                                       const int left_padding, const int content_width) {
+        const size_t index = section.index_at(position);
+        if (index >= section.size()) {
+            return;
+        }
+
+        const bool highlighted = position == current_page_ * config_.layout.items_per_page + current_selection_index_;
+
+        TerminalUtils::move_cursor(row, left_padding);
+
+        if (!section.is_item_ready(index)) {
+            awaiting_rows_ = true;
+        }
+        std::string display_text =
+            format_item_with_theme(item_label(section, index), section.is_item_selected(index), highlighted);
+        const auto [content, line_count] = center_string(display_text, content_width);
+        const auto centered_col = left_padding + (content_width - static_cast<int>(display_text.length())) / 2;
+
+        if (!highlighted) {
+            std::cout << content;
+        } else if (config_.theme.use_colors) {
+            TerminalUtils::set_color(config_.theme.accent_color);
+            std::cout << content;
+            TerminalUtils::reset_formatting();
+        } else {
+            apply_gradient_text(display_text, row, centered_col);
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_empty_section(const int row, const int left_padding,
+                                                            const int content_width) {
+        const std::string message = is_section_loading(current_section_index_)
+            ? std::format("{} {}", config_.text.loading_message, spinner_glyph())
+            : config_.text.empty_section_message;
+
+        TerminalUtils::move_cursor(row, left_padding);
+        std::cout << center_string(message, content_width).content;
+    }
+
+    template <typename SectionT>
+    std::string_view BasicNavigationTUI<SectionT>::item_label(const SectionT &section, const size_t index) const {
+        // never block the UI on a slow source: the row is repainted once it arrives
+        return section.is_item_ready(index) ? section.item_name(index) : std::string_view(config_.text.loading_message);
+    }
+
+    template <typename SectionT>
+    const typename BasicNavigationTUI<SectionT>::PrerenderedPage &BasicNavigationTUI<SectionT>::prerender_page(
+        const NavigationState state, const int page, const int content_width) {
+        const SectionHandle section_handle = (state == NavigationState::ITEM_SELECTION)
+            ? get_section_handle(current_section_index_)
+            : SectionHandle{};
+
+        auto it = std::ranges::find_if(page_cache_, [&](const PrerenderedPage &cached) {
+            return cached.state == state && cached.section == section_handle && cached.page == page &&
+                cached.content_width == content_width;
+        });
+        if (it != page_cache_.end() && is_page_current(*it)) {
+            return *it;
+        }
+
+        if (it == page_cache_.end()) {
+            if (page_cache_.size() >= max_prerendered_pages) {
+                page_cache_.erase(page_cache_.begin());
+            }
+            it = page_cache_.insert(page_cache_.end(), {state, section_handle, page, content_width, {}, {}, {}});
+        }
+
+        auto &row_sections = it->row_sections;
+        auto &row_revisions = it->row_revisions;
+        auto &rows = it->rows;
+        row_sections.clear();
+        row_revisions.clear();
+        rows.clear();
+
+        if (state == NavigationState::MAIN_MENU) {
+            const size_t first = static_cast<size_t>(page) * config_.layout.sections_per_page;
+            const size_t last = std::min(first + config_.layout.sections_per_page, sections_.size());
+            for (size_t index = first; index < last; ++index) {
+                row_sections.push_back(get_section_handle(index));
+                row_revisions.push_back(section_at(index).revision());
+                rows.push_back(center_string(section_row_text(index, false), content_width).content);
+            }
+        } else if (const auto *section = get_section(section_handle)) {
+            const size_t first = static_cast<size_t>(page) * config_.layout.items_per_page;
+            const size_t last = std::min(first + config_.layout.items_per_page, section->size());
+            for (size_t position = first; position < last; ++position) {
+                const size_t index = section->index_at(position);
+                row_sections.push_back(section_handle);
+                row_revisions.push_back(section->revision());
+                rows.push_back(center_string(format_item_with_theme(item_label(*section, index),
+                                                                    section->is_item_selected(index), false),
+                                             content_width)
+                                   .content);
+            }
+        }
+        return *it;
+    }
+
+    template <typename SectionT>
+    bool BasicNavigationTUI<SectionT>::is_page_current(const PrerenderedPage &page) const {
+        size_t expected_rows = 0;
+        if (page.state == NavigationState::MAIN_MENU) {
+            const size_t first = static_cast<size_t>(page.page) * config_.layout.sections_per_page;
+            expected_rows = std::min(first + config_.layout.sections_per_page, sections_.size()) -
+                std::min(first, sections_.size());
+        } else if (const auto *section = get_section(page.section)) {
+            const size_t first = static_cast<size_t>(page.page) * config_.layout.items_per_page;
+            expected_rows =
+                std::min(first + config_.layout.items_per_page, section->size()) - std::min(first, section->size());
+        }
+        if (expected_rows != page.rows.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < page.rows.size(); ++i) {
+            const auto *section = get_section(page.row_sections[i]);
+            if (!section || section->revision() != page.row_revisions[i]) {
+                return false;
+            }
+            if (page.state == NavigationState::MAIN_MENU &&
+                get_section_handle(static_cast<size_t>(page.page) * config_.layout.sections_per_page + i) !=
+                    page.row_sections[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::prerender_adjacent_pages() {
+        const int content_width = row_layout_.content_width;
+        if (content_width <= 0 || needs_redraw_) {
+            return;
+        }
+
+        const bool in_items = current_state_ == NavigationState::ITEM_SELECTION;
+        if (in_items && current_section_index_ >= sections_.size()) {
+            return;
+        }
+
+        const int page = in_items ? current_page_ : current_section_page_;
+        const int total_pages = calculate_total_pages();
+        const SectionHandle section_handle = in_items ? get_section_handle(current_section_index_) : SectionHandle{};
+        for (const int candidate : {page + 1, page - 1}) {
+            if (candidate < 0 || candidate >= total_pages) {
+                continue;
+            }
+
+            const auto it = std::ranges::find_if(page_cache_, [&](const PrerenderedPage &cached) {
+                return cached.state == current_state_ && cached.section == section_handle &&
+                    cached.page == candidate && cached.content_width == content_width;
+            });
+            if (it == page_cache_.end() || !is_page_current(*it)) {
+                // one page per idle tick keeps input latency unaffected
+                prerender_page(current_state_, candidate, content_width);
+                return;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    std::optional<std::string> BasicNavigationTUI<SectionT>::provided_description(const SectionT &section,
+                                                                                  const size_t index) {
+        std::string item_name(section.item_name(index));
+        std::string key = section.name + '\x1f' + item_name;
+
+        std::lock_guard lock(description_mutex_);
+        if (const auto *text = description_cache_.find(key)) {
+            return *text;
+        }
+        if (descriptions_in_flight_.contains(key)) {
+            return std::nullopt;
+        }
+
+        // only the highlighted item is worth waiting for; drop the ones scrolled past
+        description_worker_->clear();
+        descriptions_in_flight_.clear();
+        descriptions_in_flight_.insert(key);
+        description_worker_->post([this, provider = description_provider_, key = std::move(key),
+                                   section_name = section.name, item_name = std::move(item_name)] {
+            std::string text;
+            try {
+                text = provider(section_name, item_name);
+            } catch (...) {
+                // shown as "No description provided" rather than retried forever
+            }
+            {
+                std::lock_guard guard(description_mutex_);
+                description_cache_.put(key, std::move(text));
+                descriptions_in_flight_.erase(key);
+            }
+            description_arrived_.store(true, std::memory_order_release);
+        });
+        return std::nullopt;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::refresh_loaded_rows() {
+        if (description_arrived_.exchange(false, std::memory_order_acquire) && awaiting_description_) {
+            needs_redraw_ = true;
+            return;
+        }
+
+        if (!awaiting_rows_ || needs_redraw_ || current_state_ != NavigationState::ITEM_SELECTION ||
+            current_section_index_ >= sections_.size()) {
+            return;
+        }
+
+        const auto &section = section_at(current_section_index_);
+        if (section.revision() == awaiting_revision_) {
+            return;
+        }
+        awaiting_revision_ = section.revision();
+
+        if (awaiting_footer_ && section.is_item_ready(section.index_at(get_current_page_bounds().first +
+                                                                       current_selection_index_))) {
+            needs_redraw_ = true;
+            return;
+        }
+
+        // render_item_row() sets the flag again for rows that are still missing
+        awaiting_rows_ = awaiting_footer_;
+        auto [first, second] = get_current_page_bounds();
+        for (size_t position = first; position < second; ++position) {
+            if (section.is_item_ready(section.index_at(position))) {
+                invalidate_row(position);
+            } else {
+                awaiting_rows_ = true;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::sync_search_index(const bool force) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!force && now - last_index_sync_ < std::chrono::milliseconds(500)) {
+            return;
+        }
+        last_index_sync_ = now;
+
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            const SectionHandle handle = get_section_handle(i);
+            if (const auto *lazy = find_lazy(handle); (lazy && !lazy->resident) || is_section_loading(i)) {
+                continue; // keep what was indexed while loaded; index streamed sections once complete
+            }
+
+            const auto &section = section_at(i);
+            const uint64_t revision = section.content_revision();
+            if (search_index_.queued_revision(handle) == revision) {
+                continue;
+            }
+
+            if (section.has_source()) {
+                search_index_.update(handle, revision, section.source());
+            } else {
+                std::vector<std::string> names;
+                names.reserve(section.items.size());
+                for (const auto &item : section.items) {
+                    names.push_back(item.name);
+                }
+                search_index_.update(handle, revision, std::move(names));
+            }
+        }
+
+        // pick up results from segments that finished since the last keystroke
+        if (search_active_ && !force) {
+            const auto previous = search_hits_;
+            update_search();
+            if (search_hits_ != previous) {
+                needs_redraw_ = true;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::handle_search_input(const TerminalUtils::Key key, const char character) {
+        switch (key) {
+        case TerminalUtils::Key::ESCAPE:
+            search_active_ = false;
+            break;
+
+        case TerminalUtils::Key::ENTER:
+            search_active_ = false;
+            if (search_cursor_ < search_hits_.size()) {
+                jump_to_item(search_hits_[search_cursor_]);
+            }
+            break;
+
+        case TerminalUtils::Key::ARROW_UP:
+            search_cursor_ = search_cursor_ > 0 ? search_cursor_ - 1 : 0;
+            break;
+
+        case TerminalUtils::Key::ARROW_DOWN:
+            if (search_cursor_ + 1 < search_hits_.size()) {
+                ++search_cursor_;
+            }
+            break;
+
+        case TerminalUtils::Key::BACKSPACE:
+            if (!search_query_.empty()) {
+                search_query_.pop_back();
+                update_search();
+            }
+            break;
+
+        default:
+            if (std::isprint(static_cast<unsigned char>(character))) {
+                search_query_ += character;
+                update_search();
+            }
+            break;
+        }
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::update_search() {
+        const ItemRef highlighted = search_cursor_ < search_hits_.size() ? search_hits_[search_cursor_] : ItemRef{};
+        search_hits_ = search_items(search_query_, max_search_hits);
+
+        // keep the cursor on the same hit when results are refreshed
+        const auto it = std::ranges::find(search_hits_, highlighted);
+        search_cursor_ = it != search_hits_.end() ? static_cast<size_t>(it - search_hits_.begin()) : 0;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_search(const int start_row, const int left_padding,
+                                                     const int content_width) {
+        const std::string &title = config_.text.search_title;
+        TerminalUtils::move_cursor(start_row, left_padding);
+        std::cout << center_string(title, content_width).content;
+        TerminalUtils::move_cursor(start_row + 1, left_padding);
+        std::cout << center_string(std::string(title.length(), '='), content_width).content;
+
+        int row = start_row + 2 + config_.layout.vertical_padding;
+        TerminalUtils::move_cursor(row, left_padding);
+        std::cout << center_string(std::format("/ {}_", search_query_), content_width).content;
+        row += 2;
+
+        if (search_hits_.empty()) {
+            std::string message;
+            if (search_index_.building()) {
+                message = std::format("{} {}", config_.text.loading_message, spinner_glyph());
+            } else if (search_query_.size() >= TrigramIndex::min_query_length) {
+                message = config_.text.search_no_results;
+            }
+            TerminalUtils::move_cursor(row, left_padding);
+            std::cout << center_string(message, content_width).content;
+            return;
+        }
+
+        const auto per_page = static_cast<size_t>(config_.layout.items_per_page);
+        const size_t first = search_cursor_ / per_page * per_page;
+        const size_t last = std::min(first + per_page, search_hits_.size());
+        for (size_t i = first; i < last; ++i, ++row) {
+            const auto &[section_index, item_index] = search_hits_[i];
+            const auto &section = section_at(section_index);
+            const bool highlighted = i == search_cursor_;
+            const std::string text =
+                std::format("{}{} / {}", highlighted ? "> " : "  ", section.name, section.item_name(item_index));
+
+            TerminalUtils::move_cursor(row, left_padding);
+            if (highlighted && config_.theme.use_colors) {
+                TerminalUtils::set_color(config_.theme.accent_color);
+                std::cout << center_string(text, content_width).content;
+                TerminalUtils::reset_formatting();
+            } else {
+                std::cout << center_string(text, content_width).content;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_dirty_rows() {
+        std::ranges::sort(dirty_rows_);
+        const auto [last, end] = std::ranges::unique(dirty_rows_);
+        dirty_rows_.erase(last, end);
+
+        size_t first = 0;
+        size_t second = 0;
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            first = current_section_page_ * config_.layout.sections_per_page;
+            second = first + get_sections_on_current_page();
+        } else {
+            std::tie(first, second) = get_current_page_bounds();
+        }
+
+        const auto &[first_row, left_padding, content_width] = row_layout_;
+
+        if (current_state_ == NavigationState::ITEM_SELECTION && current_section_index_ < sections_.size() &&
+            section_at(current_section_index_).empty()) {
+            TerminalUtils::move_cursor(first_row, left_padding);
+            std::cout << std::string(content_width, ' ');
+            render_empty_section(first_row, left_padding, content_width);
+        }
+
+        for (const size_t position : dirty_rows_) {
+            if (position < first || position >= second) {
+                continue;
+            }
+
+            const int row = first_row + static_cast<int>(position - first);
+            TerminalUtils::move_cursor(row, left_padding);
+            std::cout << std::string(content_width, ' ');
+
+            if (current_state_ == NavigationState::MAIN_MENU) {
+                render_section_row(position, row, left_padding, content_width);
+            } else {
+                render_item_row(section_at(current_section_index_), position, row, left_padding, content_width);
+            }
+        }
+
+        dirty_rows_.clear();
+        TerminalManager::flush_output();
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::invalidate_row(const size_t position) { dirty_rows_.push_back(position); }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::render_footer(const int term_height, const int left_padding,
+                                                     const int content_width,
+                                                     const std::optional<std::string_view> item_description) {
+        // footer (description)
+        // TODO: description rendering for main sections will be added in a future
+        auto description = (item_description)
+            ? (item_description->empty() ? std::string("No description provided") : std::string(*item_description))
+            : std::string("Description (placeholder)");
+
+        auto [content, line_count] = center_string(description, content_width);
+
+        const int description_anchor_row = term_height - 4;
+        const int description_start_row = description_anchor_row - (line_count - 1);
+
+        TerminalUtils::move_cursor(description_start_row, left_padding);
+
+        std::istringstream stream(content);
+        std::string line;
+        int current_row = description_start_row;
+
+        while (std::getline(stream, line)) {
+            TerminalUtils::move_cursor(current_row, left_padding);
+            std::cout << line;
+            current_row++;
+        }
+
+        // footer (help text)
+        std::string help_text = (current_state_ == NavigationState::MAIN_MENU) ? config_.text.help_text_sections
+            : config_.enable_type_ahead                                        ? config_.text.help_text_type_ahead
+                                                                               : config_.text.help_text_items;
+        if (goto_active_) {
+            help_text = config_.text.goto_prompt + goto_query_ + "_";
+        } else if (!number_buffer_.empty()) {
+            help_text = number_buffer_ + "_";
+        } else if (search_active_) {
+            help_text = config_.text.search_help;
+        } else if ((current_state_ == NavigationState::MAIN_MENU && config_.layout.paginate_sections &&
+                    config_.text.show_page_numbers) ||
+                   (current_state_ == NavigationState::ITEM_SELECTION && config_.text.show_page_numbers)) {
+            help_text += " | " + get_page_info_string();
+        }
+
+        auto [help_content, help_line_count] = center_string(help_text, content_width);
+
+        const int help_anchor_row = term_height - 2;
+        const int help_start_row = help_anchor_row - (help_line_count - 1);
+
+        TerminalUtils::move_cursor(help_start_row, left_padding);
+
+        current_row = help_start_row;
+        std::istringstream help_stream(help_content);
+        while (std::getline(help_stream, line)) {
+            TerminalUtils::move_cursor(current_row, left_padding);
+            std::cout << line;
+            current_row++;
+        }
+    }
+
+    template <typename SectionT>
+    std::string BasicNavigationTUI<SectionT>::format_item_with_theme(const std::string_view name,
+                                                                     const bool item_selected,
+                                                                     const bool is_selected) const {
+        const std::string &prefix = item_selected ? config_.theme.selected_prefix : config_.theme.unselected_prefix;
+        // TODO: maybe add configuration for highlighted prefix?
+        std::string display_text = std::format("{}{} {}", (is_selected) ? "> " : " ", prefix, name);
+
+        return display_text;
+    }
+
+    template <typename SectionT>
+    std::string BasicNavigationTUI<SectionT>::get_page_info_string() const {
+        int total_pages = calculate_total_pages();
+        return std::format(
+            "Page {} of {}",
+            (current_state_ == NavigationState::MAIN_MENU) ? current_section_page_ + 1 : current_page_ + 1,
+            total_pages);
+    }
+
+    template <typename SectionT>
+    int BasicNavigationTUI<SectionT>::calculate_total_pages() const {
+        if (current_state_ == NavigationState::MAIN_MENU) {
+            return (!config_.layout.paginate_sections || sections_.empty())
+                ? 1
+                : (static_cast<int>((sections_.size() + config_.layout.sections_per_page - 1)) /
+                   config_.layout.sections_per_page);
+        }
+
+        if (current_section_index_ < sections_.size()) {
+            const size_t item_count = section_at(current_section_index_).size();
+            if (item_count == 0) {
+                return 1;
+            }
+            return static_cast<int>((item_count + config_.layout.items_per_page - 1) / config_.layout.items_per_page);
+        }
+
+        return 1;
+    }
+
+    template <typename SectionT>
+    std::pair<size_t, size_t> BasicNavigationTUI<SectionT>::get_current_page_bounds() const {
+        if (current_state_ != NavigationState::ITEM_SELECTION || current_section_index_ >= sections_.size()) {
+            return {0, 0};
+        }
+
+        size_t start = current_page_ * config_.layout.items_per_page;
+        size_t end = std::min(start + config_.layout.items_per_page, section_at(current_section_index_).size());
+
+        return {start, end};
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::clamp_selection() {
+        if (current_state_ == NavigationState::MAIN_MENU && current_section_index_ >= sections_.size()) {
+            current_selection_index_ = !sections_.empty() ? sections_.size() - 1 : 0;
+        } else {
+            auto [first, second] = get_current_page_bounds();
+            if (const size_t max_selection = second - first; current_selection_index_ >= max_selection) {
+                current_selection_index_ = max_selection > 0 ? max_selection - 1 : 0;
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::change_state(const NavigationState new_state) {
+        if (current_state_ != new_state) {
+            const NavigationState old_state = current_state_;
+            current_state_ = new_state;
+
+            if (on_state_changed_) {
+                on_state_changed_(old_state, new_state);
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::validate_indices() {
+        if (current_section_index_ >= sections_.size()) {
+            current_section_index_ = !sections_.empty() ? sections_.size() - 1 : 0;
+        }
+        clamp_selection();
+    }
+
+    template <typename SectionT>
+    typename BasicNavigationTUI<SectionT>::FormattedText BasicNavigationTUI<SectionT>::center_string(
+        const std::string &text, const int width) const {
+        if (!config_.layout.center_horizontally) {
+            return {text, 1};
+        }
+
+        std::string result_content;
+        auto total_lines = 0;
+        std::string current_line;
+
+        for (const char c : text) {
+            if (c == '\n') {
+                if (!current_line.empty()) {
+                    int padding = (width - static_cast<int>(current_line.length())) / 2;
+                    if (padding < 0) {
+                        padding = 0;
+                    }
+                    result_content += std::string(padding, ' ') + current_line + '\n';
+                    total_lines++;
+                    current_line.clear();
+                } else {
+                    result_content += '\n';
+                    total_lines++;
+                }
+            } else {
+                if (static_cast<int>(current_line.length()) >= width) {
+                    if (const size_t last_space = current_line.find_last_of(' ');
+                        last_space != std::string::npos && last_space > 0) {
+                        const std::string next_line = current_line.substr(last_space + 1);
+                        current_line = current_line.substr(0, last_space);
+
+                        int padding = (width - static_cast<int>(current_line.length())) / 2;
+                        if (padding < 0) {
+                            padding = 0;
+                        }
+                        result_content += std::string(padding, ' ') + current_line + '\n';
+                        total_lines++;
+
+                        current_line = next_line;
+                    } else {
+                        int padding = (width - static_cast<int>(current_line.length())) / 2;
+                        if (padding < 0) {
+                            padding = 0;
+                        }
+                        result_content += std::string(padding, ' ') + current_line + '\n';
+                        total_lines++;
+                        current_line.clear();
+                    }
+                }
+                current_line += c;
+            }
+        }
+
+        if (!current_line.empty()) {
+            int padding = (width - static_cast<int>(current_line.length())) / 2;
+            if (padding < 0) {
+                padding = 0;
+            }
+            result_content += std::string(padding, ' ') + current_line;
+            total_lines++;
+        }
+
+        return {result_content, total_lines};
+    }
+
+    template <typename SectionT>
+    SectionT &BasicNavigationTUI<SectionT>::section_at(const size_t index) {
+        return sections_[storage_index_at(index)];
+    }
+
+    template <typename SectionT>
+    const SectionT &BasicNavigationTUI<SectionT>::section_at(const size_t index) const {
+        return sections_[storage_index_at(index)];
+    }
+
+    template <typename SectionT>
+    size_t BasicNavigationTUI<SectionT>::storage_index_at(const size_t index) const {
+        if (removed_section_positions_ > 0) {
+            compact_section_order();
+        }
+        return section_order_.empty() ? index : section_order_[index];
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::compact_section_order() const {
+        std::erase(section_order_, detail::removed_section_position);
+        removed_section_positions_ = 0;
+        bool identity = true;
+        for (size_t position = 0; position < section_order_.size(); ++position) {
+            section_positions_[section_order_[position]] = static_cast<uint32_t>(position);
+            identity = identity && section_order_[position] == position;
+        }
+        if (identity) {
+            section_order_.clear();
+            section_positions_.clear();
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::register_new_sections() {
+        for (size_t storage_index = section_handles_.size(); storage_index < sections_.size(); ++storage_index) {
+            section_handles_.push_back(section_slots_.acquire(storage_index));
+            if (!section_order_.empty()) {
+                section_order_.push_back(static_cast<uint32_t>(storage_index));
+                section_positions_.push_back(static_cast<uint32_t>(section_order_.size() - 1));
+            }
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::remove_section_storage(const size_t storage_index) {
+        const size_t last = sections_.size() - 1;
+
+        if (section_order_.empty() && storage_index != last) {
+            // the tail is about to move into the hole, so storage stops matching display order
+            section_order_.resize(sections_.size());
+            std::iota(section_order_.begin(), section_order_.end(), uint32_t{0});
+            section_positions_ = section_order_;
+        }
+        if (!section_order_.empty()) {
+            // marked, not erased, so removing a section doesn't shift or search the others
+            section_order_[section_positions_[storage_index]] = detail::removed_section_position;
+            ++removed_section_positions_;
+            if (storage_index != last) {
+                section_order_[section_positions_[last]] = static_cast<uint32_t>(storage_index);
+                section_positions_[storage_index] = section_positions_[last];
+            }
+            section_positions_.pop_back();
+        }
+
+        const SectionHandle removed = section_handles_[storage_index];
+        std::erase_if(lazy_sections_, [removed](const LazySection &lazy) { return lazy.handle == removed; });
+        std::erase(loading_sections_, removed);
+        search_index_.remove(removed);
+
+        section_slots_.release(section_handles_[storage_index]);
+        if (storage_index != last) {
+            sections_[storage_index] = std::move(sections_[last]);
+            section_handles_[storage_index] = section_handles_[last];
+            section_slots_.relocate(section_handles_[storage_index], storage_index);
+        }
+        sections_.pop_back();
+        section_handles_.pop_back();
+    }
+
+    template <typename SectionT>
+    typename BasicNavigationTUI<SectionT>::LazySection *BasicNavigationTUI<SectionT>::find_lazy(
+        const SectionHandle handle) {
+        const auto it = std::ranges::find(lazy_sections_, handle, &LazySection::handle);
+        return (handle.valid() && it != lazy_sections_.end()) ? &(*it) : nullptr;
+    }
+
+    template <typename SectionT>
+    const typename BasicNavigationTUI<SectionT>::LazySection *BasicNavigationTUI<SectionT>::find_lazy(
+        const SectionHandle handle) const {
+        const auto it = std::ranges::find(lazy_sections_, handle, &LazySection::handle);
+        return (handle.valid() && it != lazy_sections_.end()) ? &(*it) : nullptr;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::load_lazy_section(LazySection &lazy) {
+        auto *section = get_section(lazy.handle);
+        if (!section) {
+            return;
+        }
+
+        std::vector<item_type> items;
+        try {
+            items = lazy.loader(*section);
+        } catch (...) {
+            // stays unloaded, the next enter tries again
+            return;
+        }
+
+        section->clear_items();
+        section->items = std::move(items);
+        section->touch();
+        if (!lazy.selected_hashes.empty()) {
+            // the loader may have reordered or changed its items, names still identify them
+            section->begin_batch();
+            for (size_t index = 0; index < section->size(); ++index) {
+                if (std::ranges::binary_search(lazy.selected_hashes, snapshot_hash(section->item_name(index)))) {
+                    section->restore_item_selected(index, true);
+                }
+            }
+            section->end_batch();
+        }
+        if (lazy.index_revision != 0 && detail::names_hash(*section) == lazy.names_hash) {
+            // same items at the same indices, so recorded steps still apply
+            journal_.rebase(lazy.handle, lazy.index_revision, section->index_revision());
+        }
+
+        // rough estimate: the items plus whatever their strings allocated
+        const size_t inline_capacity = std::string().capacity();
+        lazy.bytes = section->items.capacity() * sizeof(item_type);
+        for (const auto &item : section->items) {
+            lazy.bytes += item.name.capacity() > inline_capacity ? item.name.capacity() + 1 : 0;
+            lazy.bytes += item.description.capacity() > inline_capacity ? item.description.capacity() + 1 : 0;
+        }
+
+        lazy.resident = true;
+        lazy.selected_hashes = {};
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::unload_lazy_section(LazySection &lazy) {
+        auto *section = get_section(lazy.handle);
+        if (!section) {
+            return;
+        }
+
+        lazy.item_count = section->size();
+        lazy.selected_count = section->get_selected_count();
+        lazy.selected_hashes.clear();
+        section->for_each_selected(
+            [&](const size_t index) { lazy.selected_hashes.push_back(snapshot_hash(section->item_name(index))); });
+        std::ranges::sort(lazy.selected_hashes);
+        lazy.names_hash = detail::names_hash(*section);
+        lazy.index_revision = section->index_revision();
+
+        section->clear_items();
+        section->items.shrink_to_fit();
+        lazy.resident = false;
+        lazy.bytes = 0;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::set_description_provider(DescriptionProvider provider) {
+        if (description_worker_) {
+            description_worker_->clear();
+        }
+        {
+            std::lock_guard lock(description_mutex_);
+            description_cache_.clear();
+            description_cache_.set_capacity(config_.description_cache_entries);
+            descriptions_in_flight_.clear();
+        }
+        if (provider && !description_worker_) {
+            description_worker_ = std::make_unique<BackgroundWorker>();
+        }
+        description_provider_ = std::move(provider);
+        needs_redraw_ = true;
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::evict_lazy_sections() {
+        if (config_.lazy_memory_budget == 0) {
+            return;
+        }
+
+        const SectionHandle current = (current_state_ == NavigationState::ITEM_SELECTION)
+            ? get_section_handle(current_section_index_)
+            : SectionHandle{};
+
+        for (size_t resident = get_resident_lazy_bytes(); resident > config_.lazy_memory_budget;) {
+            LazySection *victim = nullptr;
+            for (auto &lazy : lazy_sections_) {
+                // attributes and constraints would be left pointing at items that no longer exist
+                const auto *section = get_section(lazy.handle);
+                const bool pinned = section && (!section->attributes().empty() || section->constraints());
+                if (lazy.resident && !pinned && lazy.handle != current &&
+                    (!victim || lazy.last_used < victim->last_used)) {
+                    victim = &lazy;
+                }
+            }
+            if (!victim) {
+                break;
+            }
+            resident -= victim->bytes;
+            unload_lazy_section(*victim);
+        }
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::load_lazy_selections() {
+        // the exit callback expects real items wherever something is selected
+        for (auto &lazy : lazy_sections_) {
+            if (!lazy.resident && lazy.selected_count > 0) {
+                load_lazy_section(lazy);
+            }
+        }
+    }
+
+    template <typename SectionT>
+    std::vector<std::string> BasicNavigationTUI<SectionT>::selected_names(const size_t storage_index) const {
+        const auto *lazy = find_lazy(section_handles_[storage_index]);
+        if (!lazy || lazy->resident) {
+            return sections_[storage_index].get_selected_names();
+        }
+        if (lazy->selected_count == 0) {
+            return {};
+        }
+
+        // names aren't kept while unloaded, so ask the loader again
+        std::vector<std::string> names;
+        try {
+            for (auto &item : lazy->loader(sections_[storage_index])) {
+                if (std::ranges::binary_search(lazy->selected_hashes, snapshot_hash(item.name))) {
+                    names.push_back(std::move(item.name));
+                }
+            }
+        } catch (...) {
+            // report what we can rather than failing the whole query
+        }
+        return names;
+    }
+
+    template <typename SectionT>
+    std::pair<size_t, size_t> BasicNavigationTUI<SectionT>::section_counts(const size_t index) const {
+        if (const auto *lazy = find_lazy(get_section_handle(index)); lazy && !lazy->resident) {
+            return {lazy->selected_count, lazy->item_count};
+        }
+        const auto &section = section_at(index);
+        return {section.get_selected_count(), section.size()};
+    }
+
+    template <typename SectionT>
+    void BasicNavigationTUI<SectionT>::compact_sections() {
+        if (removed_section_positions_ > 0) {
+            compact_section_order();
+        }
+        if (section_order_.empty()) {
+            return;
+        }
+
+        std::vector<SectionT> ordered;
+        std::vector<SectionHandle> handles;
+        ordered.reserve(sections_.size());
+        handles.reserve(sections_.size());
+        for (const uint32_t storage_index : section_order_) {
+            ordered.push_back(std::move(sections_[storage_index]));
+            handles.push_back(section_handles_[storage_index]);
+            section_slots_.relocate(handles.back(), handles.size() - 1);
+        }
+
+        sections_ = std::move(ordered);
+        section_handles_ = std::move(handles);
+        section_order_.clear();
+        section_positions_.clear();
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_indicators(const char selected,
+                                                                                         const char unselected) {
+        config_.theme.selected_indicator = selected;
+        config_.theme.unselected_indicator = unselected;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_prefixes(const std::string &selected,
+                                                                                       const std::string &unselected) {
+        config_.theme.selected_prefix = selected;
+        config_.theme.unselected_prefix = unselected;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_unicode(const bool enable) {
+        config_.theme.use_unicode = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_colors(const bool enable) {
+        config_.theme.use_colors = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_gradient_support(const bool enable) {
+        config_.theme.gradient_enabled = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_gradient_preset(
+        const tui_extras::GradientPreset &preset) {
+        config_.theme.gradient_preset = preset;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_gradient_randomize(const bool enable) {
+        config_.theme.gradient_randomize = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_border_style(
+        const tui_extras::BorderStyle &style) {
+        config_.theme.border_style = style;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_accent_color(
+        const tui_extras::AccentColor &color) {
+        config_.theme.accent_color = color;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_centering(const bool horizontal,
+                                                                                         const bool vertical) {
+        config_.layout.center_horizontally = horizontal;
+        config_.layout.center_vertically = vertical;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_content_width(const int min_width,
+                                                                                             const int max_width) {
+        config_.layout.min_content_width = min_width;
+        config_.layout.max_content_width = max_width;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_padding(const int vertical_padding) {
+        config_.layout.vertical_padding = vertical_padding;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_auto_resize(const bool enable) {
+        config_.layout.auto_resize_content = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_borders(const bool show) {
+        config_.layout.show_borders = show;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_items_per_page(const int count) {
+        config_.layout.items_per_page = count;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_sections_per_page(const int count) {
+        config_.layout.sections_per_page = count;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::paginate_sections(const bool paginate) {
+        config_.layout.paginate_sections = paginate;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_titles(const std::string &section_title,
+                                                                                    const std::string &item_prefix) {
+        config_.text.section_selection_title = section_title;
+        config_.text.item_selection_prefix = item_prefix;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_messages(
+        const std::string &empty_message) {
+        config_.text.empty_section_message = empty_message;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_help(const std::string &section_help,
+                                                                                  const std::string &item_help) {
+        config_.text.help_text_sections = section_help;
+        config_.text.help_text_items = item_help;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_show_help(const bool show) {
+        config_.text.show_help_text = show;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_show_pages(const bool show) {
+        config_.text.show_page_numbers = show;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::text_show_counters(const bool show) {
+        config_.text.show_counters = show;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::keys_quick_select(const bool enable) {
+        config_.enable_quick_select = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::keys_vim_style(const bool enable) {
+        config_.enable_vim_keys = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::keys_type_ahead(const bool enable) {
+        config_.enable_type_ahead = enable;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::keys_custom_shortcut(
+        const char key, const std::string &description) {
+        config_.custom_shortcuts[key] = description;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::lazy_memory_budget(const size_t bytes) {
+        config_.lazy_memory_budget = bytes;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::description_provider(
+        typename tui_type::DescriptionProvider provider, const size_t cache_entries) {
+        description_provider_ = std::move(provider);
+        config_.description_cache_entries = cache_entries;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::undo_history(const size_t entries) {
+        config_.undo_history = entries;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::autosave(const std::string &path) {
+        config_.autosave_path = path;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::run_mode(
+        const typename tui_type::RunMode mode) {
+        config_.run_mode = mode;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::headless_load_timeout(
+        const std::chrono::milliseconds timeout) {
+        config_.headless_load_timeout = timeout;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::selection_commands(
+        std::vector<std::string> commands) {
+        config_.selection_commands = std::move(commands);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::selection_script(const std::string &path) {
+        config_.selection_script = path;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::add_section(const SectionT &section) {
+        sections_.push_back(section);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::add_section(SectionT &&section) {
+        sections_.push_back(std::move(section));
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::add_sections(
+        const std::vector<SectionT> &sections) {
+        sections_.insert(sections_.end(), sections.begin(), sections.end());
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_section_selected(
+        typename tui_type::SectionSelectedCallback callback) {
+        section_selected_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_item_toggled(
+        typename tui_type::ItemToggledCallback callback) {
+        item_toggled_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_page_changed(
+        typename tui_type::PageChangedCallback callback) {
+        page_changed_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_state_changed(
+        typename tui_type::StateChangedCallback callback) {
+        state_changed_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_exit(
+        typename tui_type::ExitCallback callback) {
+        exit_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::on_custom_command(
+        typename tui_type::CustomCommandCallback callback) {
+        custom_command_callback_ = std::move(callback);
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_minimal() {
+        config_.theme.use_unicode = false;
+        config_.theme.use_colors = false;
+        config_.theme.selected_prefix = "* ";
+        config_.theme.unselected_prefix = "  ";
+        config_.theme.border_style = tui_extras::BorderStyle::ASCII;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_fancy() {
+        config_.theme.use_unicode = true;
+        config_.theme.use_colors = true;
+        config_.theme.selected_prefix = "✓ ";
+        config_.theme.unselected_prefix = "○ ";
+        config_.theme.border_style = tui_extras::BorderStyle::ROUNDED;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_retro() {
+        config_.theme.use_unicode = false;
+        config_.theme.use_colors = false;
+        config_.theme.selected_prefix = "[X] ";
+        config_.theme.unselected_prefix = "[ ] ";
+        config_.theme.border_style = tui_extras::BorderStyle::DOUBLE;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::theme_modern() {
+        config_.theme.use_unicode = true;
+        config_.theme.use_colors = true;
+        config_.theme.selected_prefix = "● ";
+        config_.theme.unselected_prefix = "○ ";
+        config_.theme.border_style = tui_extras::BorderStyle::ROUNDED;
+        config_.theme.accent_color = tui_extras::AccentColor::BLUE;
+
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_compact() {
+        config_.layout.items_per_page = 25;
+        config_.layout.show_borders = false;
+        config_.layout.center_horizontally = false;
+        config_.layout.center_vertically = false;
+        config_.layout.min_content_width = 40;
+        config_.layout.max_content_width = 60;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_comfortable() {
+        config_.layout.items_per_page = 15;
+        config_.layout.show_borders = true;
+        config_.layout.center_horizontally = false;
+        config_.layout.center_vertically = false;
+        config_.layout.min_content_width = 60;
+        config_.layout.max_content_width = 100;
+        config_.layout.vertical_padding = 2;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_fullscreen() {
+        config_.layout.items_per_page = 30;
+        config_.layout.show_borders = true;
+        config_.layout.center_horizontally = false;
+        config_.layout.center_vertically = false;
+        config_.layout.auto_resize_content = true;
+        config_.layout.min_content_width = 80;
+        config_.layout.max_content_width = 120;
+        return *this;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::layout_centered() {
+        config_.layout.center_horizontally = true;
+        config_.layout.center_vertically = false;
+        config_.layout.items_per_page = 20;
+        config_.layout.show_borders = true;
+        config_.layout.min_content_width = 60;
+        config_.layout.max_content_width = 80;
+        config_.layout.vertical_padding = 3;
+        return *this;
+    }
+
+    template <typename SectionT>
+    std::unique_ptr<BasicNavigationTUI<SectionT>> BasicNavigationBuilder<SectionT>::build() {
+        auto tui = std::make_unique<BasicNavigationTUI<SectionT>>(config_);
+
+        for (auto &section : sections_) {
+            tui->add_section(std::move(section));
+        }
+
+        if (section_selected_callback_) {
+            tui->set_section_selected_callback(section_selected_callback_);
+        }
+        if (item_toggled_callback_) {
+            tui->set_item_toggled_callback(item_toggled_callback_);
+        }
+        if (page_changed_callback_) {
+            tui->set_page_changed_callback(page_changed_callback_);
+        }
+        if (state_changed_callback_) {
+            tui->set_state_changed_callback(state_changed_callback_);
+        }
+        if (exit_callback_) {
+            tui->set_exit_callback(exit_callback_);
+        }
+        if (custom_command_callback_) {
+            tui->set_custom_command_callback(custom_command_callback_);
+        }
+        if (description_provider_) {
+            tui->set_description_provider(description_provider_);
+        }
+
+        return tui;
+    }
+
+    template <typename SectionT>
+    const typename BasicNavigationTUI<SectionT>::Config &BasicNavigationBuilder<SectionT>::get_config() const {
+        return config_;
+    }
+
+    template <typename SectionT>
+    BasicNavigationBuilder<SectionT> &BasicNavigationBuilder<SectionT>::reset() {
+        config_ = typename tui_type::Config{};
+        sections_.clear();
+
+        section_selected_callback_ = nullptr;
+        item_toggled_callback_ = nullptr;
+        page_changed_callback_ = nullptr;
+        state_changed_callback_ = nullptr;
+        exit_callback_ = nullptr;
+        custom_command_callback_ = nullptr;
+        description_provider_ = nullptr;
+
+        return *this;
+    }
+} // namespace tui
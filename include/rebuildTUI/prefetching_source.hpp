@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "background_worker.hpp"
+#include "item_source.hpp"
+#include "lru_cache.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Item source over a slow backend, fetched in pages with read-ahead
+     *
+     * Pages are fetched on a background worker and kept in an LRU cache. The
+     * source follows the pages the user views (see ItemSource::on_view()); it
+     * prefetches ahead in the direction of travel, and further the faster the
+     * user pages. Rows of pages not cached yet report is_ready() == false,
+     * so the renderer shows placeholders. name()/description() on such a row
+     * move its fetch to the front of the queue and wait for it, so selection
+     * queries always see real data. The fetcher only ever runs on the worker.
+     */
+    class PrefetchingSource final : public ItemSource {
+    public:
+        struct Row {
+            std::string name;
+            std::string description;
+        };
+
+        /**
+         * @brief Fetch `count` rows starting at `first`; runs on the worker thread
+         */
+        using PageFetcher = std::function<std::vector<Row>(size_t first, size_t count)>;
+
+        struct Options {
+            size_t page_size = 256;   ///< Rows per fetch
+            size_t cache_pages = 64;  ///< Pages kept in the LRU cache
+            size_t read_ahead = 2;    ///< Pages prefetched ahead when browsing slowly
+            size_t max_read_ahead = 16; ///< Upper bound when paging fast
+        };
+
+        struct Stats {
+            size_t hits = 0;             ///< Rows answered from the cache
+            size_t misses = 0;           ///< Rows that had to wait for a fetch
+            size_t evictions = 0;        ///< Pages dropped from the cache
+            size_t fetched_pages = 0;    ///< All pages fetched so far
+            size_t prefetched_pages = 0; ///< Pages fetched before anyone asked for them
+            size_t cached_pages = 0;
+            size_t cache_capacity = 0;
+        };
+
+        PrefetchingSource(size_t size, PageFetcher fetcher, Options options);
+        PrefetchingSource(const size_t size, PageFetcher fetcher) :
+            PrefetchingSource(size, std::move(fetcher), Options{}) {}
+
+        [[nodiscard]] size_t size() const override { return size_; }
+        [[nodiscard]] std::string_view name(size_t index) const override;
+        [[nodiscard]] std::string_view description(size_t index) const override;
+
+        [[nodiscard]] bool is_ready(size_t index) const override;
+        void on_view(size_t first, size_t last) const override;
+        [[nodiscard]] uint64_t revision() const override { return revision_.load(std::memory_order_acquire); }
+
+        void set_cache_pages(size_t pages);
+        [[nodiscard]] Stats stats() const;
+
+    private:
+        using Page = std::vector<Row>;
+
+        [[nodiscard]] const Row *row(size_t index) const;
+        void request(size_t page, bool urgent) const;
+        void run_fetch(size_t page, uint64_t generation) const;
+
+        size_t size_;
+        PageFetcher fetcher_;
+        Options options_;
+
+        mutable std::mutex mutex_;
+        mutable LruCache<size_t, std::shared_ptr<const Page>> cache_;
+        mutable std::condition_variable arrived_;
+        mutable std::unordered_map<size_t, bool> in_flight_; ///< Page -> whether somebody is waiting for it
+        mutable uint64_t generation_ = 0; ///< Bumped on direction changes to drop stale prefetches
+        mutable std::shared_ptr<const Page> pinned_[2]; ///< Keeps the pages behind returned views alive
+        mutable size_t next_pin_ = 0;
+        mutable size_t fetched_pages_ = 0;
+        mutable size_t prefetched_pages_ = 0;
+        mutable std::atomic<uint64_t> revision_{0};
+
+        // navigation tracking (UI thread only)
+        mutable std::optional<size_t> last_view_page_;
+        mutable std::chrono::steady_clock::time_point last_view_time_{};
+        mutable double pages_per_second_ = 0.0;
+        mutable int direction_ = 1;
+
+        mutable BackgroundWorker worker_; ///< Last, so pending fetches stop before the cache goes away
+    };
+
+} // namespace tui
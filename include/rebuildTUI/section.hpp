@@ -1,27 +1,96 @@
 #pragma once
 
+#include "attribute_index.hpp"
+#include "constraint_graph.hpp"
+#include "handle.hpp"
+#include "item_source.hpp"
 #include "selectable_item.hpp"
+#include "selection_events.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace tui {
 
+    /**
+     * @brief Outcome of BasicSection::reconcile()
+     */
+    struct ReconcileResult {
+        size_t inserted = 0;                 ///< Items that did not exist before
+        size_t removed = 0;                  ///< Items missing from the fresh data
+        size_t updated = 0;                  ///< Matched items whose description or name changed
+        bool section_changed = false;        ///< Section description changed
+        bool replaced = false;               ///< Item source was swapped, every row may differ
+        std::vector<size_t> dirty_positions; ///< Display positions whose row looks different now
+
+        [[nodiscard]] bool changed() const {
+            return inserted > 0 || removed > 0 || updated > 0 || section_changed || replaced ||
+                !dirty_positions.empty();
+        }
+    };
+
+    /**
+     * @brief Display order applied to a section without moving its items
+     *
+     * See BasicSection::set_view().
+     */
+    struct ItemView {
+        enum class Order {
+            natural, ///< Order items were added in, or the one set by the last reconcile() or sort_items_*()
+            name,    ///< By name, ties in natural order
+        };
+        enum class Group {
+            none,
+            selected_first,
+            selected_last,
+        };
+
+        Order order = Order::natural;
+        Group group = Group::none;
+
+        bool operator==(const ItemView &) const = default;
+    };
+
     /**
      * @brief Represents a section containing multiple selectable items
      *
      * This is a generic container that can represent any logical grouping
      * of selectable items - categories, groups, folders, sections, etc.
+     *
+     * Items are stored densely in `items`; an index is a position in that vector.
+     * Removal moves the last item into the freed slot, so the display order is
+     * kept separately (see index_at()). ItemHandle stays valid across removals.
+     *
+     * Alternatively a section can be backed by an ItemSource (see set_source()),
+     * in which case rows are read from the source and only selection state is
+     * stored here.
+     *
+     * @tparam Payload Type of the user data stored in each item
+     * @tparam SectionPayload Type of the user data stored in the section itself
      */
-    class Section {
+    template <typename Payload, typename SectionPayload = Payload>
+    class BasicSection {
     public:
-        std::string name;                  ///< Name of the section
-        std::string description;           ///< Optional description of the section
-        std::vector<SelectableItem> items; ///< Collection of selectable items in this section
+        using item_type = BasicItem<Payload>;
+        using payload_type = Payload;
+        using section_payload_type = SectionPayload;
+
+        std::string name;             ///< Name of the section
+        std::string description;      ///< Optional description of the section
+        std::vector<item_type> items; ///< Collection of selectable items in this section
 
         /**
          * @brief Optional user data that can be attached to this section
          */
-        std::any user_data;
+        TUI_NO_UNIQUE_ADDRESS SectionPayload user_data{};
 
         /**
          * @brief Optional callback function that gets called when section is entered
@@ -33,31 +102,81 @@ namespace tui {
          */
         std::function<void()> on_exit;
 
-        /**
-         * @brief Optional callback function that gets called when any item in section
-         * is toggled
-         */
-        std::function<void(size_t, bool)> on_item_toggled;
-
         // Constructors
-        explicit Section(std::string section_name) : name(std::move(section_name)) {}
-        Section(std::string section_name, std::string section_desc) :
+        explicit BasicSection(std::string section_name) : name(std::move(section_name)) {}
+        BasicSection(std::string section_name, std::string section_desc) :
             name(std::move(section_name)), description(std::move(section_desc)) {}
-        Section(std::string section_name, std::string section_desc, std::any data) :
+        BasicSection(std::string section_name, std::string section_desc, SectionPayload data) :
             name(std::move(section_name)), description(std::move(section_desc)), user_data(std::move(data)) {}
 
-        void add_item(const SelectableItem &item) { items.push_back(item); }
-        void add_item(const std::string &item_name) { items.emplace_back(item_name); }
+        /**
+         * @brief Type-erase a typed section, e.g. to show it in a default NavigationTUI
+         *
+         * Payloads are wrapped in std::any (left empty for NoPayload), so
+         * get_user_data<T>() takes the original payload type. Items keep their
+         * indices and handles; selections, order, view, attributes, constraints,
+         * the source and observers all carry over.
+         *
+         * A BasicNavigationTUI over the typed section stores it without conversion.
+         */
+        template <typename OtherPayload, typename OtherSectionPayload>
+            requires(std::is_same_v<Payload, std::any> && std::is_same_v<SectionPayload, std::any> &&
+                     !std::is_same_v<BasicSection<OtherPayload, OtherSectionPayload>, BasicSection>)
+        BasicSection(BasicSection<OtherPayload, OtherSectionPayload> &&other) :
+            name(std::move(other.name)), description(std::move(other.description)),
+            user_data(erase_payload(std::move(other.user_data))), on_enter(std::move(other.on_enter)),
+            on_exit(std::move(other.on_exit)) {
+            other.sync_handles();
+            items.reserve(other.items.size());
+            for (auto &item : other.items) {
+                auto &erased = items.emplace_back(std::move(item.name), std::move(item.description), item.id,
+                                                  erase_payload(std::move(item.user_data)));
+                erased.selected = item.selected;
+            }
+            item_slots_ = std::move(other.item_slots_);
+            item_handles_ = std::move(other.item_handles_);
+            order_ = std::move(other.order_);
+            item_ranks_ = std::move(other.item_ranks_);
+            next_rank_ = other.next_rank_;
+            view_stale_ = other.view_stale_;
+            view_ = other.view_;
+            attributes_ = std::move(other.attributes_);
+            constraints_ = std::move(other.constraints_);
+            source_ = std::move(other.source_);
+            source_selected_ = std::move(other.source_selected_);
+            source_selected_count_ = other.source_selected_count_;
+            events_ = std::move(other.events_);
+            item_toggled_subscription_ = other.item_toggled_subscription_;
+            revision_ = other.revision_;
+            selection_revision_ = other.selection_revision_;
+        }
+
+        void add_item(const item_type &item) {
+            items.push_back(item);
+            ++revision_;
+        }
+        void add_item(const std::string &item_name) {
+            items.emplace_back(item_name);
+            ++revision_;
+        }
         void add_item(const std::string &item_name, const std::string &item_desc) {
             items.emplace_back(item_name, item_desc);
+            ++revision_;
         }
         void add_item(const std::string &item_name, const std::string &item_desc, int item_id,
-                      const std::any &item_data = {}) {
+                      const Payload &item_data = {}) {
             items.emplace_back(item_name, item_desc, item_id, item_data);
+            ++revision_;
         }
 
-        void add_items(const std::vector<SelectableItem> &new_items) {
+        void add_items(const std::vector<item_type> &new_items) {
             items.insert(items.end(), new_items.begin(), new_items.end());
+            ++revision_;
+        }
+        void add_items(std::vector<item_type> &&new_items) {
+            items.insert(items.end(), std::make_move_iterator(new_items.begin()),
+                         std::make_move_iterator(new_items.end()));
+            ++revision_;
         }
         void add_items(const std::vector<std::string> &names) {
             for (const auto &name : names) {
@@ -65,11 +184,90 @@ namespace tui {
             }
         }
 
-        [[nodiscard]] size_t size() const { return items.size(); }
+        [[nodiscard]] size_t size() const { return source_ ? source_selected_.size() : items.size(); }
+
+        /**
+         * @brief Counter bumped by every change made through this class
+         *
+         * Renderers use it to reuse formatted rows. Call touch() after editing
+         * `items` directly. Includes the source's revision, so rows that finish
+         * loading in the background count as a change.
+         */
+        [[nodiscard]] uint64_t revision() const { return content_revision() + selection_revision_; }
+        void touch() {
+            ++revision_;
+            view_stale_ = view_ != ItemView{};
+            selection_bits_valid_ = false;
+        }
+
+        /**
+         * @brief Like revision(), but ignores selection changes
+         *
+         * Bumped when items are added, removed, renamed or reordered; used by
+         * indexes over item names.
+         */
+        [[nodiscard]] uint64_t content_revision() const { return revision_ + (source_ ? source_->revision() : 0); }
+
+        /**
+         * @brief Like content_revision(), but ignores source rows finishing loading
+         *
+         * Unchanged means an index still refers to the same item.
+         */
+        [[nodiscard]] uint64_t index_revision() const { return revision_; }
+
+        [[nodiscard]] bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Back this section by an item source instead of `items`
+         *
+         * `items` is cleared and selections start empty. Item pointers, handles,
+         * removal and sorting only apply to owned items; use item_name(),
+         * item_description() and is_item_selected() to read rows of either kind.
+         * Passing nullptr turns the section back into a regular one.
+         */
+        void set_source(std::shared_ptr<const ItemSource> source) {
+            clear_items();
+            view_ = ItemView{};
+            constraints_.reset();
+            source_ = std::move(source);
+            source_selected_.assign(source_ ? source_->size() : 0, false);
+            source_selected_count_ = 0;
+        }
+
+        [[nodiscard]] const std::shared_ptr<const ItemSource> &source() const { return source_; }
+        [[nodiscard]] bool has_source() const { return source_ != nullptr; }
+
+        [[nodiscard]] std::string_view item_name(const size_t index) const {
+            if (index >= size()) {
+                return {};
+            }
+            return source_ ? source_->name(index) : std::string_view(items[index].name);
+        }
+
+        [[nodiscard]] std::string_view item_description(const size_t index) const {
+            if (index >= size()) {
+                return {};
+            }
+            return source_ ? source_->description(index) : std::string_view(items[index].description);
+        }
+
+        [[nodiscard]] bool is_item_selected(const size_t index) const { return index < size() && selected_at(index); }
 
-        [[nodiscard]] bool empty() const { return items.empty(); }
+        /**
+         * @brief Whether the row can be read without waiting on a slow source
+         */
+        [[nodiscard]] bool is_item_ready(const size_t index) const { return !source_ || source_->is_ready(index); }
+
+        /**
+         * @brief Tell the source which rows [first, last) are on screen, so it can fetch ahead
+         */
+        void notify_view(const size_t first, const size_t last) const {
+            if (source_) {
+                source_->on_view(first, last);
+            }
+        }
 
-        SelectableItem *get_item(const size_t index) {
+        item_type *get_item(const size_t index) {
             if (index < items.size()) {
                 return &items[index];
             }
@@ -77,7 +275,7 @@ namespace tui {
             return nullptr;
         }
 
-        [[nodiscard]] const SelectableItem *get_item(const size_t index) const {
+        [[nodiscard]] const item_type *get_item(const size_t index) const {
             if (index < items.size()) {
                 return &items[index];
             }
@@ -85,101 +283,196 @@ namespace tui {
             return nullptr;
         }
 
-        SelectableItem *get_item_by_name(const std::string &name) {
+        item_type *get_item_by_name(const std::string &name) {
             const auto it = std::find_if(items.begin(), items.end(),
-                                         [&name](const SelectableItem &item) { return item.name == name; });
+                                         [&name](const item_type &item) { return item.name == name; });
             return (it != items.end()) ? &(*it) : nullptr;
         }
-        SelectableItem *get_item_by_id(int id) {
-            const auto it = std::ranges::find_if(items, [id](const SelectableItem &item) { return item.id == id; });
+        item_type *get_item_by_id(int id) {
+            const auto it = std::ranges::find_if(items, [id](const item_type &item) { return item.id == id; });
             return (it != items.end()) ? &(*it) : nullptr;
         }
 
+        /**
+         * @brief Flip an item; with constraints set, dependent items follow in the same batch
+         *
+         * @return False if index is out of range or the constraints refuse the change
+         */
         bool toggle_item(size_t index) {
-            if (index < items.size()) {
-                bool new_state = items[index].toggle();
-                if (on_item_toggled) {
-                    on_item_toggled(index, new_state);
+            if (index < size()) {
+                const bool selected = !selected_at(index);
+                if (constraints_) {
+                    return apply_constrained(index, selected);
                 }
+                store_selected(index, selected);
+                record_change(index, selected);
                 return true;
             }
             return false;
         }
 
         bool set_item_selected(const size_t index, const bool selected) {
-            if (index < items.size()) {
-                bool changed = items[index].set_selected(selected);
-                if (changed && on_item_toggled) {
-                    on_item_toggled(index, selected);
+            if (index < size()) {
+                if (constraints_ && selected_at(index) != selected) {
+                    return apply_constrained(index, selected);
+                }
+                bool changed = store_selected(index, selected);
+                if (changed) {
+                    record_change(index, selected);
                 }
                 return changed;
             }
             return false;
         }
 
+        /**
+         * @brief Like set_item_selected(), but bypasses constraints
+         *
+         * For replaying recorded changes, which already contain their cascades.
+         */
+        bool restore_item_selected(const size_t index, const bool selected) {
+            if (index >= size() || !store_selected(index, selected)) {
+                return false;
+            }
+            record_change(index, selected);
+            return true;
+        }
+
         [[nodiscard]] size_t get_selected_count() const {
-            return std::ranges::count_if(items, [](const SelectableItem &item) { return item.selected; });
+            if (source_) {
+                return source_selected_count_;
+            }
+            return std::ranges::count_if(items, [](const item_type &item) { return item.selected; });
         }
 
         [[nodiscard]] std::vector<std::string> get_selected_names() const {
             std::vector<std::string> selected;
-            for (const auto &item : items) {
-                if (item.selected) {
-                    selected.push_back(item.name);
+            for (size_t position = 0; position < size(); ++position) {
+                if (const size_t index = index_at(position); selected_at(index)) {
+                    selected.emplace_back(item_name(index));
                 }
             }
             return selected;
         }
 
-        [[nodiscard]] std::vector<SelectableItem> get_selected_items() const {
-            std::vector<SelectableItem> selected;
-            for (const auto &item : items) {
-                if (item.selected) {
-                    selected.push_back(item);
+        /**
+         * @brief Selected items; rows of a source-backed section are copied into items
+         */
+        [[nodiscard]] std::vector<item_type> get_selected_items() const {
+            std::vector<item_type> selected;
+            for (size_t position = 0; position < size(); ++position) {
+                const size_t index = index_at(position);
+                if (!selected_at(index)) {
+                    continue;
+                }
+                if (source_) {
+                    selected.emplace_back(std::string(item_name(index)), std::string(item_description(index)));
+                    selected.back().selected = true;
+                } else {
+                    selected.push_back(items[index]);
                 }
             }
             return selected;
         }
 
+        /**
+         * @brief Indices of selected items, in display order
+         */
         [[nodiscard]] std::vector<size_t> get_selected_indices() const {
             std::vector<size_t> indices;
-            for (size_t i = 0; i < items.size(); ++i) {
-                if (items[i].selected) {
-                    indices.push_back(i);
+            for (size_t position = 0; position < size(); ++position) {
+                if (const size_t index = index_at(position); selected_at(index)) {
+                    indices.push_back(index);
                 }
             }
             return indices;
         }
 
+        /**
+         * @brief Call fn(index) for each selected item in display order, without collecting them
+         *
+         * fn must not change the section's selection.
+         */
+        template <typename Fn>
+        void for_each_selected(Fn &&fn) const {
+            sync_handles();
+            if (order_.empty()) {
+                // display order is storage order, so the selection bitmap can be walked directly
+                selection_bits().for_each([&](const uint32_t index) { fn(static_cast<size_t>(index)); });
+                return;
+            }
+            for (const uint32_t index : order_) {
+                if (selected_at(index)) {
+                    fn(static_cast<size_t>(index));
+                }
+            }
+        }
+
         void clear_selections() {
-            for (size_t i = 0; i < items.size(); ++i) {
-                if (items[i].selected) {
-                    items[i].set_selected(false);
-                    if (on_item_toggled) {
-                        on_item_toggled(i, false);
-                    }
+            begin_batch();
+            for (size_t i = 0; i < size(); ++i) {
+                if (store_selected(i, false)) {
+                    record_change(i, false);
                 }
             }
+            end_batch();
         }
 
         void select_all() {
-            for (size_t i = 0; i < items.size(); ++i) {
-                if (!items[i].selected) {
-                    items[i].set_selected(true);
-                    if (on_item_toggled) {
-                        on_item_toggled(i, true);
-                    }
+            begin_batch();
+            for (size_t i = 0; i < size(); ++i) {
+                if (store_selected(i, true)) {
+                    record_change(i, true);
                 }
             }
+            end_batch();
         }
 
         void invert_selections() {
-            for (size_t i = 0; i < items.size(); ++i) {
-                bool new_state = items[i].toggle();
-                if (on_item_toggled) {
-                    on_item_toggled(i, new_state);
-                }
+            begin_batch();
+            for (size_t i = 0; i < size(); ++i) {
+                const bool selected = !selected_at(i);
+                store_selected(i, selected);
+                record_change(i, selected);
+            }
+            end_batch();
+        }
+
+        /**
+         * @brief Subscribe to selection changes of this section
+         *
+         * Observers are called once per operation with every change it made,
+         * e.g. select_all() results in a single call.
+         */
+        SubscriptionId subscribe(ItemEventBus::Observer observer, const ChangeFilter &filter = {}) {
+            return events_.subscribe(std::move(observer), filter);
+        }
+
+        bool unsubscribe(const SubscriptionId id) { return events_.unsubscribe(id); }
+
+        [[nodiscard]] bool has_observers() const { return !events_.empty(); }
+
+        /**
+         * @brief Start collecting changes instead of publishing them one by one
+         *
+         * Batches nest; observers are notified when the outermost batch ends.
+         */
+        void begin_batch() { ++batch_depth_; }
+
+        /**
+         * @brief Finish a batch started with begin_batch()
+         *
+         * @return Changes published by this call; empty while an outer batch is still open
+         */
+        std::vector<ItemChange> end_batch() {
+            if (batch_depth_ == 0 || --batch_depth_ > 0) {
+                return {};
             }
+
+            std::vector<ItemChange> changes = std::move(pending_changes_);
+            pending_changes_.clear();
+            events_.publish(changes);
+            return changes;
         }
 
         [[nodiscard]] std::string get_display_string() const {
@@ -196,43 +489,412 @@ namespace tui {
             return base;
         }
 
+        /**
+         * @brief Remove an item without shifting the others in storage
+         *
+         * The last item is moved into the freed index; its handle keeps resolving.
+         * Other indices and pointers stay put. Removal is O(1): the freed display
+         * position is only marked, and the display order is compacted once by
+         * the next read. The first removal from a section whose display order
+         * is plain storage order builds that order once.
+         */
         bool remove_item(const size_t index) {
-            if (index < items.size()) {
-                using diff_t = typename decltype(items)::difference_type;
+            if (index >= items.size()) {
+                return false;
+            }
+            // a full sync would compact the positions earlier removals marked
+            if (item_handles_.size() != items.size() || view_stale_) {
+                sync_handles();
+            }
 
-                items.erase(items.begin() + static_cast<diff_t>(index));
-                return true;
+            const size_t last = items.size() - 1;
+            if (order_.empty() && index != last) {
+                // the tail is about to move into the hole, so storage stops matching display order
+                order_.resize(items.size());
+                std::iota(order_.begin(), order_.end(), uint32_t{0});
+                positions_valid_ = false;
             }
-            return false;
+            if (!order_.empty()) {
+                if (!positions_valid_) {
+                    rebuild_positions();
+                }
+                // the view stays sorted: the tail keeps its place, only under its new index
+                order_[positions_[index]] = removed_position;
+                ++removed_positions_;
+                if (index != last) {
+                    order_[positions_[last]] = static_cast<uint32_t>(index);
+                    positions_[index] = positions_[last];
+                }
+                positions_.pop_back();
+            }
+
+            if (index != last) {
+                attributes_.relocate(static_cast<uint32_t>(last), static_cast<uint32_t>(index));
+            } else {
+                attributes_.erase_item(static_cast<uint32_t>(index));
+            }
+            if (selection_bits_valid_) {
+                selection_bits_.remove(static_cast<uint32_t>(index));
+                selection_bits_.relocate(static_cast<uint32_t>(last), static_cast<uint32_t>(index));
+            }
+
+            ++revision_;
+            item_slots_.release(item_handles_[index]);
+            if (index != last) {
+                items[index] = std::move(items[last]);
+                item_handles_[index] = item_handles_[last];
+                item_slots_.relocate(item_handles_[index], index);
+            }
+            items.pop_back();
+            item_handles_.pop_back();
+            return true;
+        }
+
+        bool remove_item(const ItemHandle handle) {
+            const auto index = index_of(handle);
+            return index.has_value() && remove_item(*index);
         }
 
         bool remove_item_by_name(const std::string &name) {
             const auto it =
-                std::ranges::find_if(items, [&name](const SelectableItem &item) { return item.name == name; });
-            if (it != items.end()) {
-                items.erase(it);
-                return true;
-            }
-            return false;
+                std::ranges::find_if(items, [&name](const item_type &item) { return item.name == name; });
+            return it != items.end() && remove_item(static_cast<size_t>(it - items.begin()));
         }
 
-        void clear_items() { items.clear(); }
+        void clear_items() {
+            sync_handles();
+            for (const auto handle : item_handles_) {
+                item_slots_.release(handle);
+            }
+            items.clear();
+            item_handles_.clear();
+            order_.clear();
+            positions_.clear();
+            removed_positions_ = 0;
+            view_stale_ = false;
+            attributes_.clear();
+            selection_bits_valid_ = false;
+            ++revision_;
+        }
 
+        /**
+         * @brief Physically sort items by name
+         *
+         * Indices change; prefer set_view() when they must stay stable.
+         */
         void sort_items_by_name() {
-            std::ranges::sort(items, [](const SelectableItem &a, const SelectableItem &b) { return a.name < b.name; });
+            sort_storage([](const item_type &a, const item_type &b) { return a.name < b.name; });
         }
 
+        /**
+         * @brief Physically move selected items to the front or back
+         *
+         * The order is not kept up to date while toggling; set_view() with a
+         * group does that without moving items.
+         */
         void sort_items_by_selection(bool selected_first = true) {
-            std::ranges::sort(items, [selected_first](const SelectableItem &a, const SelectableItem &b) {
+            sort_storage([selected_first](const item_type &a, const item_type &b) {
                 return selected_first ? a.selected && !b.selected : !a.selected && b.selected;
             });
         }
 
-        [[nodiscard]] bool has_user_data() const { return user_data.has_value(); }
+        /**
+         * @brief Show items sorted and/or grouped by selection without moving them
+         *
+         * The view is a permutation over `items`, so indices, ids, handles and
+         * callbacks are unaffected; index_at() and position_of() follow it.
+         * Toggling an item repositions just that item by binary search, large
+         * batches and touch() re-sort once. Only owned items can be viewed:
+         * returns false for a source-backed section.
+         */
+        bool set_view(const ItemView view) {
+            if (source_) {
+                return false;
+            }
+            if (view != view_) {
+                sync_handles();
+                view_ = view;
+                rebuild_view();
+                ++revision_;
+            }
+            return true;
+        }
+
+        [[nodiscard]] const ItemView &view() const { return view_; }
+
+        /**
+         * @brief Give an item a value for an attribute key, replacing its previous one
+         *
+         * Attributes are indexed as bitmaps for filter() and facet_counts(), and
+         * follow their item through removal, sorting and reconcile().
+         */
+        bool set_item_attribute(const size_t index, const std::string_view key, const std::string_view value) {
+            return index < size() && attributes_.set(static_cast<uint32_t>(index), key, value);
+        }
+
+        bool clear_item_attribute(const size_t index, const std::string_view key) {
+            return index < size() && attributes_.erase(static_cast<uint32_t>(index), key);
+        }
+
+        [[nodiscard]] std::optional<std::string_view> item_attribute(const size_t index,
+                                                                     const std::string_view key) const {
+            return attributes_.get(static_cast<uint32_t>(index), key);
+        }
+
+        [[nodiscard]] const AttributeIndex &attributes() const { return attributes_; }
+
+        /**
+         * @brief Enforce requirements, conflicts and radio groups on single-item changes
+         *
+         * toggle_item() and set_item_selected() propagate through the graph,
+         * visiting only items that have to change, and publish the cascade as
+         * one batch. Changes the constraints can't satisfy are refused. Bulk
+         * operations like select_all() and direct edits of `items` are not
+         * checked. Returns false for a source-backed section.
+         */
+        bool set_constraints(std::shared_ptr<const ConstraintGraph> constraints) {
+            if (source_ && constraints) {
+                return false;
+            }
+            constraints_ = std::move(constraints);
+            return true;
+        }
+
+        [[nodiscard]] const std::shared_ptr<const ConstraintGraph> &constraints() const { return constraints_; }
+
+        /**
+         * @brief Indices of the items matching query, e.g. `tag("arch") == "x86_64" && !selected`
+         *
+         * Evaluated with bitmap operations; the selection bitmap is kept up to
+         * date by toggles and only rebuilt after touch() or structural changes.
+         */
+        [[nodiscard]] Bitmap filter(const Query &query) const {
+            static const Bitmap none;
+            return attributes_.evaluate(query, static_cast<uint32_t>(size()),
+                                        query.uses_selection() ? selection_bits() : none);
+        }
+
+        [[nodiscard]] size_t count_matching(const Query &query) const { return filter(query).cardinality(); }
+
+        /**
+         * @brief For each value of key, how many items matching within carry it
+         */
+        [[nodiscard]] std::vector<AttributeIndex::Facet> facet_counts(const std::string_view key,
+                                                                      const Query &within = {}) const {
+            return attributes_.facet_counts(key, filter(within));
+        }
+
+        /**
+         * @brief Bring item handles, the display order and the selection bitmap up to date
+         *
+         * Const accessors refresh these lazily, so their first call after a
+         * change writes to the section. Until the next change, accessors only
+         * read after this, and several threads may query the section at once.
+         */
+        void prepare_reads() const { (void)selection_bits(); }
+
+        /**
+         * @brief Stable handle of the item currently stored at index
+         */
+        [[nodiscard]] ItemHandle handle_of(const size_t index) const {
+            sync_handles();
+            return (index < item_handles_.size()) ? item_handles_[index] : ItemHandle{};
+        }
+
+        /**
+         * @brief Current index of a handle, or nullopt if the item was removed
+         */
+        [[nodiscard]] std::optional<size_t> index_of(const ItemHandle handle) const {
+            sync_handles();
+            return item_slots_.find(handle);
+        }
+
+        item_type *get_item(const ItemHandle handle) {
+            const auto index = index_of(handle);
+            return index ? &items[*index] : nullptr;
+        }
+
+        [[nodiscard]] const item_type *get_item(const ItemHandle handle) const {
+            const auto index = index_of(handle);
+            return index ? &items[*index] : nullptr;
+        }
+
+        /**
+         * @brief Index of the item shown at a display position
+         */
+        [[nodiscard]] size_t index_at(const size_t position) const {
+            sync_handles();
+            return (order_.empty() || position >= order_.size()) ? position : order_[position];
+        }
+
+        /**
+         * @brief Update this section in place from freshly loaded data
+         *
+         * Items are matched by id when the fresh item has a non-zero id, by name
+         * otherwise. Matched items keep their selection state, handle and index;
+         * only description (and name, for id matches) are taken from the fresh
+         * item. Unmatched live items are removed, new ones appended, and the
+         * display order follows the fresh data. Observers and callbacks of this
+         * section are kept.
+         *
+         * If either side is backed by an ItemSource, the rows are replaced
+         * wholesale and selections carry over by name.
+         */
+        ReconcileResult reconcile(BasicSection &&fresh) {
+            ReconcileResult result;
+            sync_handles();
+            ++revision_;
+
+            if (description != fresh.description) {
+                description = std::move(fresh.description);
+                result.section_changed = true;
+            }
+
+            if (source_ || fresh.source_) {
+                replace_rows(std::move(fresh), result);
+                return result;
+            }
+
+            selection_bits_valid_ = false;
+            std::vector<ItemHandle> old_sequence(items.size());
+            for (size_t position = 0; position < items.size(); ++position) {
+                old_sequence[position] = item_handles_[index_at(position)];
+            }
+
+            std::unordered_map<int, size_t> by_id;
+            std::unordered_map<std::string_view, std::vector<size_t>> by_name;
+            for (size_t index = 0; index < items.size(); ++index) {
+                if (items[index].id != 0) {
+                    by_id.emplace(items[index].id, index);
+                }
+                by_name[items[index].name].push_back(index);
+            }
+
+            std::vector<bool> matched(items.size(), false);
+            std::vector<ItemHandle> new_sequence;
+            std::unordered_set<uint32_t> updated; ///< Handle slots
+            std::vector<item_type> appended;
+            new_sequence.reserve(fresh.items.size());
+
+            for (auto &fresh_item : fresh.items) {
+                size_t match = items.size();
+                if (fresh_item.id != 0) {
+                    if (const auto it = by_id.find(fresh_item.id); it != by_id.end() && !matched[it->second]) {
+                        match = it->second;
+                    }
+                } else if (const auto it = by_name.find(fresh_item.name); it != by_name.end()) {
+                    for (const size_t candidate : it->second) {
+                        if (!matched[candidate]) {
+                            match = candidate;
+                            break;
+                        }
+                    }
+                }
+
+                if (match == items.size()) {
+                    new_sequence.push_back(ItemHandle{}); // resolved once appended
+                    appended.push_back(std::move(fresh_item));
+                    continue;
+                }
+
+                matched[match] = true;
+                auto &live = items[match];
+                if (live.name != fresh_item.name || live.description != fresh_item.description) {
+                    updated.insert(item_handles_[match].slot);
+                }
+                live.name = std::move(fresh_item.name);
+                live.description = std::move(fresh_item.description);
+                live.user_data = std::move(fresh_item.user_data);
+                new_sequence.push_back(item_handles_[match]);
+            }
+
+            // by_name views the names of live items; drop it before items start moving
+            by_name.clear();
+
+            std::vector<ItemHandle> stale;
+            for (size_t index = 0; index < matched.size(); ++index) {
+                if (!matched[index]) {
+                    stale.push_back(item_handles_[index]);
+                }
+            }
+            for (const auto handle : stale) {
+                remove_item(handle);
+            }
+            result.removed = stale.size();
+
+            auto next_appended = appended.begin();
+            for (auto &handle : new_sequence) {
+                if (!handle.valid()) {
+                    items.push_back(std::move(*next_appended++));
+                    sync_handles();
+                    handle = item_handles_.back();
+                }
+            }
+            result.inserted = appended.size();
+            result.updated = updated.size();
+
+            std::vector<uint32_t> fresh_index(items.size());
+            for (uint32_t position = 0; position < new_sequence.size(); ++position) {
+                fresh_index[*item_slots_.find(new_sequence[position])] = position;
+                item_ranks_[new_sequence[position].slot] = next_rank_++;
+            }
+            attributes_ = std::move(fresh.attributes_);
+            attributes_.permute(fresh_index);
+            rebuild_view();
+            for (size_t position = 0; position < new_sequence.size(); ++position) {
+                new_sequence[position] = item_handles_[index_at(position)];
+            }
+
+            for (size_t position = 0; position < new_sequence.size(); ++position) {
+                if (position >= old_sequence.size() || old_sequence[position] != new_sequence[position] ||
+                    updated.contains(new_sequence[position].slot)) {
+                    result.dirty_positions.push_back(position);
+                }
+            }
+            for (size_t position = new_sequence.size(); position < old_sequence.size(); ++position) {
+                result.dirty_positions.push_back(position);
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Display position of the item stored at index
+         */
+        [[nodiscard]] size_t position_of(const size_t index) const {
+            sync_handles();
+            if (order_.empty()) {
+                return index;
+            }
+            if (view_ != ItemView{}) {
+                return index < items.size() ? find_in_view(index, items[index].selected) : order_.size();
+            }
+            const auto it = std::ranges::find(order_, static_cast<uint32_t>(index));
+            return static_cast<size_t>(it - order_.begin());
+        }
+
+        [[nodiscard]] bool has_user_data() const {
+            if constexpr (std::is_same_v<SectionPayload, std::any>) {
+                return user_data.has_value();
+            } else {
+                return !std::is_empty_v<SectionPayload>;
+            }
+        }
 
+        [[nodiscard]] const SectionPayload &payload() const { return user_data; }
+        SectionPayload &payload() { return user_data; }
+
+        /**
+         * @brief The payload as T; typed sections only accept their own payload type
+         */
         template <typename T>
+            requires(std::is_same_v<SectionPayload, std::any> || std::is_same_v<T, SectionPayload>)
         T get_user_data() const {
-            return std::any_cast<T>(user_data);
+            if constexpr (std::is_same_v<SectionPayload, std::any>) {
+                return std::any_cast<T>(user_data);
+            } else {
+                return user_data;
+            }
         }
 
         template <typename T>
@@ -245,8 +907,24 @@ namespace tui {
 
         void set_exit_callback(std::function<void()> callback) { on_exit = std::move(callback); }
 
+        /**
+         * @brief Per-item convenience callback, replaces the previously set one
+         *
+         * Implemented as a bus subscription that unpacks the batch.
+         */
         void set_item_toggled_callback(std::function<void(size_t, bool)> callback) {
-            on_item_toggled = std::move(callback);
+            if (item_toggled_subscription_ != 0) {
+                events_.unsubscribe(item_toggled_subscription_);
+                item_toggled_subscription_ = 0;
+            }
+            if (callback) {
+                item_toggled_subscription_ =
+                    events_.subscribe([callback = std::move(callback)](std::span<const ItemChange> changes) {
+                        for (const auto &change : changes) {
+                            callback(change.item_index, change.selected);
+                        }
+                    });
+            }
         }
 
         void trigger_enter() const {
@@ -261,9 +939,318 @@ namespace tui {
             }
         }
 
-        bool operator==(const Section &other) const { return name == other.name; }
-        bool operator!=(const Section &other) const { return !(*this == other); }
-        bool operator<(const Section &other) const { return name < other.name; }
+        bool operator==(const BasicSection &other) const { return name == other.name; }
+        bool operator!=(const BasicSection &other) const { return !(*this == other); }
+        bool operator<(const BasicSection &other) const { return name < other.name; }
+
+    private:
+        template <typename, typename>
+        friend class BasicSection;
+
+        template <typename T>
+        static std::any erase_payload(T &&payload) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<T>, NoPayload>) {
+                return {};
+            } else {
+                return std::any(std::forward<T>(payload));
+            }
+        }
+
+        // lazily extended, so items appended directly to `items` get handles too
+        mutable SlotTable<ItemTag> item_slots_;
+        mutable std::vector<ItemHandle> item_handles_; ///< index -> handle
+        mutable std::vector<uint32_t> order_;          ///< position -> index, empty while identical
+        mutable std::vector<uint32_t> positions_;      ///< index -> position in order_, while positions_valid_
+        mutable bool positions_valid_ = false;
+        mutable size_t removed_positions_ = 0;         ///< Entries of order_ marked by remove_item()
+        mutable std::vector<uint64_t> item_ranks_;     ///< handle slot -> natural order, ties views
+        mutable uint64_t next_rank_ = 0;
+        mutable bool view_stale_ = false; ///< order_ must be re-sorted before use
+        ItemView view_;
+
+        AttributeIndex attributes_;
+        std::shared_ptr<const ConstraintGraph> constraints_;
+        mutable Bitmap selection_bits_; ///< Selected indices, for queries
+        mutable bool selection_bits_valid_ = false;
+
+        std::shared_ptr<const ItemSource> source_;
+        std::vector<bool> source_selected_; ///< Selection bitset of a source-backed section
+        size_t source_selected_count_ = 0;
+
+        ItemEventBus events_;
+        std::vector<ItemChange> pending_changes_;
+        size_t batch_depth_ = 0;
+        uint64_t revision_ = 0;
+        uint64_t selection_revision_ = 0;
+        SubscriptionId item_toggled_subscription_ = 0;
+
+        void sync_handles() const {
+            if (removed_positions_ > 0) {
+                compact_order();
+            }
+            if (item_handles_.size() > items.size()) {
+                // items were erased behind our back; old handles can't be trusted anymore
+                for (const auto handle : item_handles_) {
+                    item_slots_.release(handle);
+                }
+                item_handles_.clear();
+                order_.clear();
+                positions_valid_ = false;
+                view_stale_ = view_ != ItemView{};
+                selection_bits_valid_ = false;
+            }
+            if (view_ != ItemView{} && items.size() - item_handles_.size() > max_view_insertions) {
+                view_stale_ = true;
+            }
+            for (size_t index = item_handles_.size(); index < items.size(); ++index) {
+                item_handles_.push_back(item_slots_.acquire(index));
+                const uint32_t slot = item_handles_.back().slot;
+                if (slot >= item_ranks_.size()) {
+                    item_ranks_.resize(slot + 1);
+                }
+                item_ranks_[slot] = next_rank_++;
+                if (selection_bits_valid_ && items[index].selected) {
+                    selection_bits_.add(static_cast<uint32_t>(index));
+                }
+
+                if (view_stale_) {
+                    continue;
+                }
+                if (view_ != ItemView{}) {
+                    const auto position = static_cast<std::ptrdiff_t>(view_insert_point(index, items[index].selected));
+                    order_.insert(order_.begin() + position, static_cast<uint32_t>(index));
+                    positions_valid_ = false;
+                } else if (!order_.empty()) {
+                    order_.push_back(static_cast<uint32_t>(index));
+                    if (positions_valid_) {
+                        positions_.push_back(static_cast<uint32_t>(order_.size() - 1));
+                    }
+                }
+            }
+            if (view_stale_) {
+                rebuild_view();
+            }
+        }
+
+        /// Beyond this many appended or toggled items at once, re-sorting beats inserting one by one
+        static constexpr size_t max_view_insertions = 64;
+        /// Marks an order_ entry whose item was removed, until compact_order()
+        static constexpr uint32_t removed_position = std::numeric_limits<uint32_t>::max();
+
+        [[nodiscard]] bool view_less(const size_t a, const bool a_selected, const size_t b,
+                                     const bool b_selected) const {
+            if (view_.group != ItemView::Group::none && a_selected != b_selected) {
+                return a_selected == (view_.group == ItemView::Group::selected_first);
+            }
+            if (view_.order == ItemView::Order::name) {
+                if (const int order = items[a].name.compare(items[b].name); order != 0) {
+                    return order < 0;
+                }
+            }
+            return item_ranks_[item_handles_[a].slot] < item_ranks_[item_handles_[b].slot];
+        }
+
+        /// Position where index belongs in the sorted view, given its selection state
+        [[nodiscard]] size_t view_insert_point(const size_t index, const bool selected) const {
+            const auto it = std::ranges::lower_bound(order_, static_cast<uint32_t>(index),
+                                                     [&](const uint32_t a, const uint32_t b) {
+                                                         return view_less(a, items[a].selected, b, selected);
+                                                     });
+            return static_cast<size_t>(it - order_.begin());
+        }
+
+        /// Position of index in the view; selected is the state the view last saw
+        [[nodiscard]] size_t find_in_view(const size_t index, const bool selected) const {
+            const size_t position = view_insert_point(index, selected);
+            if (position < order_.size() && order_[position] == index) {
+                return position;
+            }
+            // a name was edited without touch(); the view is still a permutation
+            return static_cast<size_t>(std::ranges::find(order_, static_cast<uint32_t>(index)) - order_.begin());
+        }
+
+        /**
+         * @brief Re-sort order_ from scratch
+         *
+         * Without a view this restores natural order, and clears order_ when
+         * that matches storage.
+         */
+        void rebuild_view() const {
+            view_stale_ = false;
+            removed_positions_ = 0;
+            positions_valid_ = false;
+            order_.resize(items.size());
+            std::iota(order_.begin(), order_.end(), uint32_t{0});
+            std::ranges::sort(order_, [this](const uint32_t a, const uint32_t b) {
+                return view_less(a, items[a].selected, b, items[b].selected);
+            });
+            if (view_ == ItemView{} && std::ranges::is_sorted(order_)) {
+                order_.clear();
+            }
+        }
+
+        /// Drop the positions remove_item() marked
+        void compact_order() const {
+            std::erase(order_, removed_position);
+            removed_positions_ = 0;
+            positions_valid_ = false;
+        }
+
+        void rebuild_positions() const {
+            positions_.resize(items.size());
+            for (size_t position = 0; position < order_.size(); ++position) {
+                if (order_[position] != removed_position) {
+                    positions_[order_[position]] = static_cast<uint32_t>(position);
+                }
+            }
+            positions_valid_ = true;
+        }
+
+        /// Move a toggled item to its new place in a grouped view
+        void reposition_in_view(const size_t index, const bool selected) {
+            if (source_ || view_.group == ItemView::Group::none || view_stale_) {
+                return;
+            }
+            if (batch_depth_ > 0 && pending_changes_.size() >= max_view_insertions) {
+                view_stale_ = true;
+                return;
+            }
+            // an item appended since the last sync is placed by the sync, already in its new state
+            const bool placed = index < item_handles_.size();
+            sync_handles();
+            if (!placed) {
+                return;
+            }
+            positions_valid_ = false;
+            order_.erase(order_.begin() + static_cast<std::ptrdiff_t>(find_in_view(index, !selected)));
+            order_.insert(order_.begin() + static_cast<std::ptrdiff_t>(view_insert_point(index, selected)),
+                          static_cast<uint32_t>(index));
+        }
+
+        template <typename Compare>
+        void sort_storage(Compare compare) {
+            sync_handles();
+
+            std::vector<uint32_t> permutation(items.size());
+            std::iota(permutation.begin(), permutation.end(), uint32_t{0});
+            std::ranges::sort(permutation,
+                              [&](const uint32_t a, const uint32_t b) { return compare(items[a], items[b]); });
+
+            std::vector<item_type> sorted;
+            std::vector<ItemHandle> handles;
+            sorted.reserve(items.size());
+            handles.reserve(items.size());
+            for (const uint32_t index : permutation) {
+                sorted.push_back(std::move(items[index]));
+                handles.push_back(item_handles_[index]);
+                item_slots_.relocate(handles.back(), handles.size() - 1);
+            }
+
+            items = std::move(sorted);
+            item_handles_ = std::move(handles);
+            for (const auto handle : item_handles_) {
+                item_ranks_[handle.slot] = next_rank_++;
+            }
+            attributes_.permute(permutation);
+            selection_bits_valid_ = false;
+            rebuild_view();
+            ++revision_;
+        }
+
+        [[nodiscard]] const Bitmap &selection_bits() const {
+            sync_handles();
+            if (!selection_bits_valid_) {
+                selection_bits_.clear();
+                for (size_t index = 0; index < size(); ++index) {
+                    if (selected_at(index)) {
+                        selection_bits_.add(static_cast<uint32_t>(index));
+                    }
+                }
+                selection_bits_valid_ = true;
+            }
+            return selection_bits_;
+        }
+
+        [[nodiscard]] bool selected_at(const size_t index) const {
+            return source_ ? static_cast<bool>(source_selected_[index]) : items[index].selected;
+        }
+
+        bool store_selected(const size_t index, const bool selected) {
+            if (!source_) {
+                return items[index].set_selected(selected);
+            }
+            if (source_selected_[index] == selected) {
+                return false;
+            }
+            source_selected_[index] = selected;
+            selected ? ++source_selected_count_ : --source_selected_count_;
+            return true;
+        }
+
+        void replace_rows(BasicSection &&fresh, ReconcileResult &result) {
+            std::vector<std::string> kept = get_selected_names();
+            const std::unordered_set<std::string_view> selected_names(kept.begin(), kept.end());
+
+            result.removed = size();
+            result.inserted = fresh.size();
+            result.replaced = true;
+
+            if (fresh.source_) {
+                set_source(std::move(fresh.source_));
+            } else {
+                set_source(nullptr);
+                items = std::move(fresh.items);
+                sync_handles();
+            }
+            attributes_ = std::move(fresh.attributes_);
+
+            if (selected_names.empty()) {
+                return;
+            }
+            for (size_t index = 0; index < size(); ++index) {
+                if (selected_names.contains(item_name(index))) {
+                    store_selected(index, true);
+                }
+            }
+        }
+
+        bool apply_constrained(const size_t index, const bool selected) {
+            const auto state = [this](const ItemHandle item) -> std::optional<bool> {
+                const auto at = item_slots_.find(item);
+                return at ? std::optional(items[*at].selected) : std::nullopt;
+            };
+            const auto changes = constraints_->propagate(handle_of(index), selected, state);
+            if (!changes) {
+                return false;
+            }
+
+            begin_batch();
+            for (const auto &[item, value] : *changes) {
+                const size_t at = *item_slots_.find(item);
+                store_selected(at, value);
+                record_change(at, value);
+            }
+            end_batch();
+            return true;
+        }
+
+        void record_change(const size_t index, const bool selected) {
+            ++selection_revision_;
+            reposition_in_view(index, selected);
+            if (selection_bits_valid_) {
+                selected ? selection_bits_.add(static_cast<uint32_t>(index))
+                         : selection_bits_.remove(static_cast<uint32_t>(index));
+            }
+            if (batch_depth_ > 0) {
+                pending_changes_.push_back({index, selected});
+            } else if (!events_.empty()) {
+                const ItemChange change{index, selected};
+                events_.publish(std::span(&change, 1));
+            }
+        }
     };
 
+    using Section = BasicSection<std::any>;       ///< Section with type-erased user data (default)
+    using PlainSection = BasicSection<NoPayload>; ///< Section without any user data
+
 } // namespace tui
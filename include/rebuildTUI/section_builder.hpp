@@ -1,7 +1,9 @@
 #pragma once
 
 #include "section.hpp"
+#include "thread_pool.hpp"
 
+#include <concepts>
 #include <memory>
 
 namespace tui {
@@ -20,47 +22,57 @@ namespace tui {
      *     .add_items({"Normalize volume", "Enable equalizer"})
      *     .on_enter([]() { std::cout << "Entered audio settings\n"; })
      *     .build();
+     *
+     * BasicSectionBuilder<Payload> builds BasicSection<Payload> with typed payloads.
      */
-    class SectionBuilder {
+    template <typename Payload, typename SectionPayload = Payload>
+    class BasicSectionBuilder {
+    public:
+        using section_type = BasicSection<Payload, SectionPayload>;
+        using item_type = typename section_type::item_type;
+
     private:
         std::string name_;
         std::string description_;
-        std::vector<SelectableItem> items_;
-        std::any user_data_;
+        std::vector<item_type> items_;
+        SectionPayload user_data_{};
         std::function<void()> on_enter_;
         std::function<void()> on_exit_;
         std::function<void(size_t, bool)> on_item_toggled_;
+        std::vector<std::pair<ItemEventBus::Observer, ChangeFilter>> observers_;
+        ItemView view_;
 
     public:
-        explicit SectionBuilder(std::string name) : name_(std::move(name)) {}
+        explicit BasicSectionBuilder(std::string name) : name_(std::move(name)) {}
 
         /**
          * @brief Set section description
          */
-        SectionBuilder &description(const std::string &desc) {
+        BasicSectionBuilder &description(const std::string &desc) {
             description_ = desc;
             return *this;
         }
 
-        SectionBuilder &add_item(const std::string &name) {
+        BasicSectionBuilder &add_item(const std::string &name) {
             items_.emplace_back(name);
             return *this;
         }
-        SectionBuilder &add_item(const std::string &name, const std::string &desc) {
+        BasicSectionBuilder &add_item(const std::string &name, const std::string &desc) {
             items_.emplace_back(name, desc);
             return *this;
         }
-        SectionBuilder &add_item(const std::string &name, const std::string &desc, int id, const std::any &data = {}) {
+        BasicSectionBuilder &add_item(const std::string &name, const std::string &desc, int id,
+                                      const Payload &data = {}) {
             items_.emplace_back(name, desc, id, data);
             return *this;
         }
 
-        SectionBuilder &add_item(const SelectableItem &item) {
+        BasicSectionBuilder &add_item(const item_type &item) {
             items_.push_back(item);
             return *this;
         }
 
-        SectionBuilder &add_items(const std::vector<std::string> &names) {
+        BasicSectionBuilder &add_items(const std::vector<std::string> &names) {
             for (const auto &name : names) {
                 items_.emplace_back(name);
             }
@@ -68,7 +80,7 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &add_items(const std::vector<std::pair<std::string, std::string>> &items) {
+        BasicSectionBuilder &add_items(const std::vector<std::pair<std::string, std::string>> &items) {
             for (const auto &[name, desc] : items) {
                 items_.emplace_back(name, desc);
             }
@@ -76,20 +88,22 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &add_items(const std::vector<SelectableItem> &items) {
+        BasicSectionBuilder &add_items(const std::vector<item_type> &items) {
             items_.insert(items_.end(), items.begin(), items.end());
             return *this;
         }
 
         template <typename Iterator>
-        SectionBuilder &add_items_from_range(Iterator begin, Iterator end) {
+        BasicSectionBuilder &add_items_from_range(Iterator begin, Iterator end) {
             for (auto it = begin; it != end; ++it) {
                 items_.emplace_back(*it);
             }
             return *this;
         }
 
-        SectionBuilder &add_generated_items(const size_t count, const std::function<std::string(size_t)> &generator) {
+        BasicSectionBuilder &add_generated_items(const size_t count,
+                                                 const std::function<std::string(size_t)> &generator) {
+            items_.reserve(items_.size() + count);
             for (size_t i = 0; i < count; ++i) {
                 items_.emplace_back(generator(i));
             }
@@ -97,37 +111,73 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &add_generated_items(const size_t count,
-                                            const std::function<SelectableItem(size_t)> &generator) {
+        BasicSectionBuilder &add_generated_items(const size_t count,
+                                                 const std::function<item_type(size_t)> &generator) {
+            items_.reserve(items_.size() + count);
             for (size_t i = 0; i < count; ++i) {
                 items_.push_back(generator(i));
             }
             return *this;
         }
 
+        /**
+         * @brief Generator returning an item or a name, called without std::function indirection
+         */
+        template <typename Generator>
+            requires std::invocable<const Generator &, size_t> &&
+            std::constructible_from<item_type, std::invoke_result_t<const Generator &, size_t>>
+        BasicSectionBuilder &add_generated_items(const size_t count, const Generator &generator) {
+            items_.reserve(items_.size() + count);
+            for (size_t i = 0; i < count; ++i) {
+                items_.emplace_back(generator(i));
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Like add_generated_items(), but fills chunks concurrently on ThreadPool::shared()
+         *
+         * The generator is called from several threads at once, so it must not
+         * share unsynchronized state. Items keep index order.
+         */
+        template <typename Generator>
+            requires std::invocable<const Generator &, size_t> &&
+            std::constructible_from<item_type, std::invoke_result_t<const Generator &, size_t>>
+        BasicSectionBuilder &add_generated_items_parallel(const size_t count, const Generator &generator) {
+            // items have no default constructor; empty names fit in SSO, so the placeholders cost no allocation
+            const size_t first = items_.size();
+            items_.resize(first + count, item_type(std::string()));
+            ThreadPool::shared().parallel_for(count, 1024, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    items_[first + i] = item_type(generator(i));
+                }
+            });
+            return *this;
+        }
+
         template <typename T>
-        SectionBuilder &user_data(const T &data) {
+        BasicSectionBuilder &user_data(const T &data) {
             user_data_ = data;
             return *this;
         }
 
-        SectionBuilder &on_enter(std::function<void()> callback) {
+        BasicSectionBuilder &on_enter(std::function<void()> callback) {
             on_enter_ = std::move(callback);
             return *this;
         }
 
-        SectionBuilder &on_exit(std::function<void()> callback) {
+        BasicSectionBuilder &on_exit(std::function<void()> callback) {
             on_exit_ = std::move(callback);
             return *this;
         }
 
-        SectionBuilder &on_item_toggled(std::function<void(size_t, bool)> callback) {
+        BasicSectionBuilder &on_item_toggled(std::function<void(size_t, bool)> callback) {
             on_item_toggled_ = std::move(callback);
             return *this;
         }
 
-        SectionBuilder &callbacks(std::function<void()> enter_cb, std::function<void()> exit_cb,
-                                  std::function<void(size_t, bool)> toggle_cb = nullptr) {
+        BasicSectionBuilder &callbacks(std::function<void()> enter_cb, std::function<void()> exit_cb,
+                                       std::function<void(size_t, bool)> toggle_cb = nullptr) {
             on_enter_ = std::move(enter_cb);
             on_exit_ = std::move(exit_cb);
             if (toggle_cb) {
@@ -137,7 +187,7 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &select_items(const std::vector<size_t> &indices) {
+        BasicSectionBuilder &select_items(const std::vector<size_t> &indices) {
             for (size_t index : indices) {
                 if (index < items_.size()) {
                     items_[index].selected = true;
@@ -146,10 +196,10 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &select_items(const std::vector<std::string> &names) {
+        BasicSectionBuilder &select_items(const std::vector<std::string> &names) {
             for (const auto &name : names) {
                 auto it = std::find_if(items_.begin(), items_.end(),
-                                       [&name](const SelectableItem &item) { return item.name == name; });
+                                       [&name](const item_type &item) { return item.name == name; });
                 if (it != items_.end()) {
                     it->selected = true;
                 }
@@ -157,54 +207,79 @@ namespace tui {
             return *this;
         }
 
-        SectionBuilder &select_all() {
+        BasicSectionBuilder &select_all() {
             for (auto &item : items_) {
                 item.selected = true;
             }
             return *this;
         }
 
-        SectionBuilder &select_none() {
+        BasicSectionBuilder &select_none() {
             for (auto &item : items_) {
                 item.selected = false;
             }
             return *this;
         }
 
-        SectionBuilder &sort_items() {
+        BasicSectionBuilder &sort_items() {
             std::sort(items_.begin(), items_.end(),
-                      [](const SelectableItem &a, const SelectableItem &b) { return a.name < b.name; });
+                      [](const item_type &a, const item_type &b) { return a.name < b.name; });
             return *this;
         }
 
-        SectionBuilder &reverse_items() {
+        /**
+         * @brief Keep the built section sorted and/or grouped without moving items (see Section::set_view())
+         */
+        BasicSectionBuilder &view(const ItemView view) {
+            view_ = view;
+            return *this;
+        }
+
+        BasicSectionBuilder &reverse_items() {
             std::reverse(items_.begin(), items_.end());
             return *this;
         }
 
-        SectionBuilder &set_item_callbacks(const std::function<void(bool)> &callback) {
-            for (auto &item : items_) {
-                item.set_toggle_callback(callback);
-            }
+        /**
+         * @brief Call the same callback for every toggled item of the section
+         *
+         * Registered once as a section observer instead of being copied into each item.
+         */
+        BasicSectionBuilder &set_item_callbacks(const std::function<void(bool)> &callback) {
+            observers_.emplace_back(
+                [callback](std::span<const ItemChange> changes) {
+                    for (const auto &change : changes) {
+                        callback(change.selected);
+                    }
+                },
+                ChangeFilter{});
+            return *this;
+        }
+
+        /**
+         * @brief Register a batched selection observer on the built section
+         */
+        BasicSectionBuilder &subscribe(ItemEventBus::Observer observer, const ChangeFilter &filter = {}) {
+            observers_.emplace_back(std::move(observer), filter);
             return *this;
         }
 
-        SectionBuilder &apply_to_items(const std::function<void(SelectableItem &)> &func) {
+        BasicSectionBuilder &apply_to_items(const std::function<void(item_type &)> &func) {
             for (auto &item : items_) {
                 func(item);
             }
             return *this;
         }
 
-        SectionBuilder &filter_items(std::function<bool(const SelectableItem &)> predicate) {
+        BasicSectionBuilder &filter_items(std::function<bool(const item_type &)> predicate) {
             items_.erase(std::remove_if(items_.begin(), items_.end(),
-                                        [&predicate](const SelectableItem &item) { return !predicate(item); }),
+                                        [&predicate](const item_type &item) { return !predicate(item); }),
                          items_.end());
             return *this;
         }
 
-        Section build() {
-            Section section(name_, description_, user_data_);
+        section_type build() {
+            section_type section(name_, description_, user_data_);
             section.items = std::move(items_);
 
             if (on_enter_) {
@@ -216,28 +291,37 @@ namespace tui {
             if (on_item_toggled_) {
                 section.set_item_toggled_callback(on_item_toggled_);
             }
+            for (const auto &[observer, filter] : observers_) {
+                section.subscribe(observer, filter);
+            }
+            section.set_view(view_);
 
             return section;
         }
 
-        std::unique_ptr<Section> build_unique() { return std::make_unique<Section>(build()); }
+        std::unique_ptr<section_type> build_unique() { return std::make_unique<section_type>(build()); }
 
-        std::shared_ptr<Section> build_shared() { return std::make_shared<Section>(build()); }
+        std::shared_ptr<section_type> build_shared() { return std::make_shared<section_type>(build()); }
 
         [[nodiscard]] size_t item_count() const { return items_.size(); }
         [[nodiscard]] bool empty() const { return items_.empty(); }
 
-        SectionBuilder &reset() {
+        BasicSectionBuilder &reset() {
             description_.clear();
             items_.clear();
-            user_data_.reset();
+            user_data_ = SectionPayload{};
             on_enter_ = nullptr;
             on_exit_ = nullptr;
             on_item_toggled_ = nullptr;
+            observers_.clear();
+            view_ = ItemView{};
             return *this;
         }
     };
 
+    using SectionBuilder = BasicSectionBuilder<std::any>;
+    using PlainSectionBuilder = BasicSectionBuilder<NoPayload>;
+
     /**
      * @brief Builder for creating multiple sections at once
      */
@@ -2,16 +2,38 @@
 
 #include <any>
 #include <format>
-#include <functional>
 #include <string>
+#include <type_traits>
 #include <utility>
 
+// MSVC ignores the standard attribute and only honours its own spelling
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TUI_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define TUI_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 namespace tui {
 
+    /**
+     * @brief Empty payload for items and sections that carry no user data
+     *
+     * Stored with [[no_unique_address]], so it takes no space in the owning object.
+     */
+    struct NoPayload {
+        bool operator==(const NoPayload &) const = default;
+    };
+
     /**
      * @brief Represents a single selectable item that can be toggled
+     *
+     * @tparam Payload Type of the user data stored inline in the item. std::any keeps the
+     * classic type-erased behaviour, NoPayload removes the member entirely.
      */
-    struct SelectableItem {
+    template <typename Payload>
+    struct BasicItem {
+        using payload_type = Payload;
+
         std::string name; ///< Display name of the item
         std::string description; ///< Optional description or tooltip
         bool selected = false; ///< Whether this item is currently selected
@@ -23,31 +45,26 @@ namespace tui {
          * This allows users to store any additional data they need
          * associated with this item (e.g., configuration values, callbacks, etc.)
          */
-        std::any user_data;
+        TUI_NO_UNIQUE_ADDRESS Payload user_data{};
 
-        /**
-         * @brief Optional callback function that gets called when item is toggled
-         *
-         * This allows for custom behavior when an item's selection state changes
-         */
-        std::function<void(bool)> on_toggle;
+        explicit BasicItem(std::string item_name) : name(std::move(item_name)) {}
 
-        explicit SelectableItem(std::string item_name) : name(std::move(item_name)) {}
-
-        SelectableItem(std::string item_name, std::string item_desc) :
+        BasicItem(std::string item_name, std::string item_desc) :
             name(std::move(item_name)), description(std::move(item_desc)) {}
 
-        SelectableItem(std::string item_name, std::string item_desc, const int item_id) :
+        BasicItem(std::string item_name, std::string item_desc, const int item_id) :
             name(std::move(item_name)), description(std::move(item_desc)), id(item_id) {}
 
-        SelectableItem(std::string item_name, std::string item_desc, const int item_id, std::any data) :
+        BasicItem(std::string item_name, std::string item_desc, const int item_id, Payload data) :
             name(std::move(item_name)), description(std::move(item_desc)), id(item_id), user_data(std::move(data)) {}
 
+        /**
+         * @brief Flip the selection state
+         *
+         * Items do not notify anybody; toggle observers live on the owning section.
+         */
         bool toggle() {
             selected = !selected;
-            if (on_toggle) {
-                on_toggle(selected);
-            }
             return selected;
         }
 
@@ -61,9 +78,6 @@ namespace tui {
         bool set_selected(bool new_state) {
             if (selected != new_state) {
                 selected = new_state;
-                if (on_toggle) {
-                    on_toggle(selected);
-                }
                 return true;
             }
             return false;
@@ -85,22 +99,43 @@ namespace tui {
             return (!description.empty()) ? std::format("{} - {}", name, description) : name;
         }
 
-        [[nodiscard]] bool has_user_data() const { return user_data.has_value(); }
+        [[nodiscard]] bool has_user_data() const {
+            if constexpr (std::is_same_v<Payload, std::any>) {
+                return user_data.has_value();
+            } else {
+                return !std::is_empty_v<Payload>;
+            }
+        }
+
+        /**
+         * @brief Typed access to the payload, no casts involved
+         */
+        [[nodiscard]] const Payload &payload() const { return user_data; }
+        Payload &payload() { return user_data; }
 
+        /**
+         * @brief The payload as T; typed items only accept their own payload type
+         */
         template <typename T>
+            requires(std::is_same_v<Payload, std::any> || std::is_same_v<T, Payload>)
         T get_user_data() const {
-            return std::any_cast<T>(user_data);
+            if constexpr (std::is_same_v<Payload, std::any>) {
+                return std::any_cast<T>(user_data);
+            } else {
+                return user_data;
+            }
         }
         template <typename T>
         void set_user_data(const T &data) {
             user_data = data;
         }
 
-        void set_toggle_callback(std::function<void(bool)> callback) { on_toggle = std::move(callback); }
-
-        bool operator<(const SelectableItem &other) const { return name < other.name; }
-        bool operator==(const SelectableItem &other) const { return id == other.id && name == other.name; }
-        bool operator!=(const SelectableItem &other) const { return !(*this == other); }
+        bool operator<(const BasicItem &other) const { return name < other.name; }
+        bool operator==(const BasicItem &other) const { return id == other.id && name == other.name; }
+        bool operator!=(const BasicItem &other) const { return !(*this == other); }
     };
 
+    using SelectableItem = BasicItem<std::any>; ///< Item with type-erased user data (default)
+    using PlainItem = BasicItem<NoPayload>;     ///< Item without any user data
+
 } // namespace tui
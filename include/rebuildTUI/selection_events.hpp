@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace tui {
+
+    /**
+     * @brief Selection change of a single item, as published by a section
+     */
+    struct ItemChange {
+        size_t item_index; ///< Index of the item inside its section
+        bool selected;     ///< New selection state
+    };
+
+    /**
+     * @brief Selection change as published by NavigationTUI to its global observers
+     */
+    struct SelectionChange {
+        size_t section_index; ///< Index of the section the item belongs to
+        size_t item_index;    ///< Index of the item inside its section
+        bool selected;        ///< New selection state
+    };
+
+    /**
+     * @brief Subscription filter applied before a batch is handed to an observer
+     */
+    struct ChangeFilter {
+        static constexpr size_t any_section = std::numeric_limits<size_t>::max();
+
+        bool selections = true;             ///< Deliver items that became selected
+        bool deselections = true;           ///< Deliver items that became unselected
+        size_t section_index = any_section; ///< Restrict to one section (global observers only)
+
+        [[nodiscard]] bool passes_everything() const {
+            return selections && deselections && section_index == any_section;
+        }
+
+        template <typename Event>
+        [[nodiscard]] bool matches(const Event &event) const {
+            if constexpr (requires { event.section_index; }) {
+                if (section_index != any_section && event.section_index != section_index) {
+                    return false;
+                }
+            }
+            return event.selected ? selections : deselections;
+        }
+    };
+
+    using SubscriptionId = size_t;
+
+    /**
+     * @brief Minimal observer list delivering selection changes in batches
+     *
+     * Observers receive every change of one operation in a single call, so bulk
+     * operations cost one indirect call per observer instead of one per item.
+     *
+     * Observers may subscribe and unsubscribe (themselves included) from inside
+     * the callback. Those changes take effect once the outermost publish()
+     * returns: a new observer gets the next batch, not the current one, and a
+     * removed observer isn't called again, even by the publish() in progress.
+     */
+    template <typename Event>
+    class EventBus {
+    public:
+        using Observer = std::function<void(std::span<const Event>)>;
+
+        SubscriptionId subscribe(Observer observer, const ChangeFilter &filter = {}) {
+            const SubscriptionId id = next_id_++;
+            // the list being dispatched must not reallocate under the running observer
+            (publishing_ > 0 ? added_ : subscribers_).push_back({id, filter, std::move(observer)});
+            return id;
+        }
+
+        bool unsubscribe(const SubscriptionId id) {
+            const auto matches = [id](const Subscriber &s) { return s.id == id && !s.removed; };
+            if (const auto it = std::ranges::find_if(added_, matches); it != added_.end()) {
+                added_.erase(it);
+                return true;
+            }
+            const auto it = std::ranges::find_if(subscribers_, matches);
+            if (it == subscribers_.end()) {
+                return false;
+            }
+            if (publishing_ > 0) {
+                it->removed = true; // erased once dispatch is over
+                has_removed_ = true;
+            } else {
+                subscribers_.erase(it);
+            }
+            return true;
+        }
+
+        void publish(std::span<const Event> events) {
+            if (events.empty()) {
+                return;
+            }
+
+            // applies queued subscribe/unsubscribe calls, also when an observer throws
+            struct Dispatch {
+                EventBus &bus;
+                explicit Dispatch(EventBus &bus) : bus(bus) { ++bus.publishing_; }
+                ~Dispatch() {
+                    if (--bus.publishing_ == 0) {
+                        bus.apply_queued();
+                    }
+                }
+            } dispatch(*this);
+
+            // added_ takes new observers, so the size is fixed while dispatching
+            for (size_t i = 0, count = subscribers_.size(); i < count; ++i) {
+                const auto &subscriber = subscribers_[i];
+                if (subscriber.removed) {
+                    continue;
+                }
+
+                if (subscriber.filter.passes_everything()) {
+                    subscriber.observer(events);
+                    continue;
+                }
+
+                std::vector<Event> filtered;
+                for (const auto &event : events) {
+                    if (subscriber.filter.matches(event)) {
+                        filtered.push_back(event);
+                    }
+                }
+                if (!filtered.empty()) {
+                    subscriber.observer(filtered);
+                }
+            }
+        }
+
+        [[nodiscard]] bool empty() const { return size() == 0; }
+        [[nodiscard]] size_t size() const {
+            const auto removed = has_removed_ ? std::ranges::count_if(subscribers_, &Subscriber::removed) : 0;
+            return subscribers_.size() - static_cast<size_t>(removed) + added_.size();
+        }
+        void clear() {
+            added_.clear();
+            if (publishing_ == 0) {
+                subscribers_.clear();
+                return;
+            }
+            for (auto &subscriber : subscribers_) {
+                subscriber.removed = true;
+            }
+            has_removed_ = !subscribers_.empty();
+        }
+
+    private:
+        struct Subscriber {
+            SubscriptionId id;
+            ChangeFilter filter;
+            Observer observer;
+            bool removed = false; ///< Unsubscribed while publishing
+        };
+
+        void apply_queued() {
+            if (has_removed_) {
+                std::erase_if(subscribers_, [](const Subscriber &s) { return s.removed; });
+                has_removed_ = false;
+            }
+            if (!added_.empty()) {
+                subscribers_.insert(subscribers_.end(), std::make_move_iterator(added_.begin()),
+                                    std::make_move_iterator(added_.end()));
+                added_.clear();
+            }
+        }
+
+        std::vector<Subscriber> subscribers_;
+        std::vector<Subscriber> added_; ///< Subscribed while publishing, joins subscribers_ afterwards
+        size_t publishing_ = 0;         ///< Nesting depth of publish()
+        bool has_removed_ = false;
+        SubscriptionId next_id_ = 1;
+    };
+
+    using ItemEventBus = EventBus<ItemChange>;
+    using SelectionEventBus = EventBus<SelectionChange>;
+
+} // namespace tui
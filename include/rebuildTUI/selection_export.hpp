@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace tui {
+
+    enum class ExportFormat {
+        lines,      ///< One item name per line
+        json_lines, ///< {"section": ..., "item": ...} per line
+        nul,        ///< Item names terminated by '\0', for xargs -0
+    };
+
+    /**
+     * @brief Writes selected items to a file descriptor as they are visited
+     *
+     * Output goes through a fixed buffer straight to the fd, so exporting
+     * half a million items never holds more than one buffer of text.
+     *
+     * @code
+     * SelectionExporter exporter(STDOUT_FILENO, ExportFormat::nul);
+     * for (const auto &section : sections) {
+     *     exporter.add(section);
+     * }
+     * if (!exporter.finish()) { ... }
+     * @endcode
+     */
+    class SelectionExporter {
+    public:
+        explicit SelectionExporter(int fd, ExportFormat format = ExportFormat::lines, size_t buffer_size = 64 * 1024);
+
+        /**
+         * @brief Writes out what is still buffered; use finish() to learn whether that worked
+         */
+        ~SelectionExporter();
+
+        SelectionExporter(const SelectionExporter &) = delete;
+        SelectionExporter &operator=(const SelectionExporter &) = delete;
+
+        /**
+         * @brief Export the selected items of a section, owned or source-backed, in display order
+         */
+        template <typename SectionT>
+        void add(const SectionT &section) {
+            section.for_each_selected([&](const size_t index) { add(section.name, section.item_name(index)); });
+        }
+
+        void add(std::string_view section, std::string_view item);
+
+        /**
+         * @brief Write out the buffer
+         *
+         * @return false if any write failed; nothing is written after a failure
+         */
+        bool finish();
+
+        [[nodiscard]] size_t exported() const { return exported_; }
+        [[nodiscard]] bool failed() const { return failed_; }
+
+    private:
+        void append_json_string(std::string_view text);
+        void flush_buffer();
+
+        int fd_;
+        ExportFormat format_;
+        std::vector<char> buffer_;
+        size_t capacity_;
+        size_t exported_ = 0;
+        bool failed_ = false;
+    };
+
+} // namespace tui
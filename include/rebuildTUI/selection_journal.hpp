@@ -0,0 +1,128 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <vector>
+#include "handle.hpp"
+#include "selection_events.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Immutable sorted set of item indices in its most compact encoding
+     *
+     * Stored as a plain index list, as (start, length) runs or as a bitmap
+     * over [first, last], whichever takes the fewest words: a single toggle
+     * is one index, select-all on a million items one run, a scattered
+     * invert a bitmap.
+     */
+    class IndexSet {
+    public:
+        IndexSet() = default;
+
+        /**
+         * @param sorted Strictly increasing indices
+         */
+        explicit IndexSet(std::span<const uint32_t> sorted);
+
+        template <typename Fn>
+        void for_each(Fn &&fn) const {
+            switch (encoding_) {
+            case Encoding::list:
+                for (const uint32_t index : words_) {
+                    fn(index);
+                }
+                break;
+            case Encoding::runs:
+                for (size_t run = 0; run < words_.size(); run += 2) {
+                    for (uint32_t index = words_[run]; index < words_[run] + words_[run + 1]; ++index) {
+                        fn(index);
+                    }
+                }
+                break;
+            case Encoding::bitmap:
+                for (size_t word = 0; word < words_.size(); ++word) {
+                    for (uint32_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+                        fn(first_ + static_cast<uint32_t>(word * 32 + std::countr_zero(bits)));
+                    }
+                }
+                break;
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return count_; }
+        [[nodiscard]] bool empty() const { return count_ == 0; }
+        [[nodiscard]] size_t memory_usage() const { return sizeof(*this) + words_.capacity() * sizeof(uint32_t); }
+
+    private:
+        enum class Encoding : uint8_t { list, runs, bitmap };
+
+        Encoding encoding_ = Encoding::list;
+        uint32_t count_ = 0;
+        uint32_t first_ = 0;          ///< Value of bit 0 in the bitmap encoding
+        std::vector<uint32_t> words_; ///< Indices, start/length pairs or bitmap words
+    };
+
+    /**
+     * @brief Bounded undo/redo history of selection changes
+     *
+     * Each recorded batch keeps only its net effect, split into the items it
+     * selected and the items it deselected. Entries carry the section's
+     * index revision, so callers can tell when indices no longer refer to the
+     * same items.
+     */
+    class SelectionJournal {
+    public:
+        struct Entry {
+            SectionHandle section;
+            uint64_t index_revision = 0;
+            IndexSet selected;   ///< Items the batch selected
+            IndexSet deselected; ///< Items the batch deselected
+
+            [[nodiscard]] size_t memory_usage() const {
+                return sizeof(*this) + selected.memory_usage() + deselected.memory_usage() - 2 * sizeof(IndexSet);
+            }
+        };
+
+        explicit SelectionJournal(size_t limit = 100) : limit_(limit) {}
+
+        /**
+         * @brief Add a batch as the newest undo step and forget the redo steps
+         *
+         * Items flipped an even number of times within the batch cancel out; a
+         * batch without net effect is not recorded.
+         */
+        void record(SectionHandle section, uint64_t index_revision, std::span<const ItemChange> changes);
+
+        std::optional<Entry> pop_undo();
+        std::optional<Entry> pop_redo();
+        void push_undo(Entry entry);
+        void push_redo(Entry entry);
+
+        [[nodiscard]] bool can_undo() const { return !undo_.empty(); }
+        [[nodiscard]] bool can_redo() const { return !redo_.empty(); }
+
+        /**
+         * @brief Move entries of section from one index revision to another
+         *
+         * For when the section's items were rebuilt and are known to sit at the
+         * same indices again, so its steps stay replayable.
+         */
+        void rebase(SectionHandle section, uint64_t from_revision, uint64_t to_revision);
+
+        void set_limit(size_t limit);
+        [[nodiscard]] size_t limit() const { return limit_; }
+        void clear();
+
+        [[nodiscard]] size_t memory_usage() const;
+
+    private:
+        size_t limit_;
+        std::deque<Entry> undo_; ///< Oldest first
+        std::deque<Entry> redo_; ///< Oldest first
+    };
+
+} // namespace tui
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tui {
+
+    /**
+     * @brief 64-bit hash of an item or section name as stored in snapshots
+     *
+     * Reads eight bytes at a time and is fixed across runs and platforms, unlike std::hash.
+     */
+    uint64_t snapshot_hash(std::string_view name);
+
+    /**
+     * @brief Collects selection state and writes it as a binary snapshot
+     *
+     * Layout (version 1, little-endian, every block 8-byte aligned):
+     *
+     * - header: magic "RTUISNAP", version, section count, file size
+     * - section table: name hash, offsets of the two arrays below, item count, selected count
+     * - per section: one name hash per item, then a bitmap with one bit per item
+     *
+     * @code
+     * SnapshotWriter writer;
+     * for (const auto &section : sections) {
+     *     writer.add(section);
+     * }
+     * writer.write("selection.snapshot");
+     * @endcode
+     */
+    class SnapshotWriter {
+    public:
+        void begin_section(std::string_view name, size_t item_count = 0);
+        void add_item(std::string_view name, bool selected);
+
+        /**
+         * @brief As begin_section() and add_item(), for names already hashed with snapshot_hash()
+         */
+        void begin_hashed_section(uint64_t name_hash, size_t item_count = 0);
+        void add_hashed_item(uint64_t name_hash, bool selected);
+
+        /**
+         * @brief Add a whole section, owned or source-backed
+         */
+        template <typename SectionT>
+        void add(const SectionT &section) {
+            begin_section(section.name, section.size());
+            for (size_t index = 0; index < section.size(); ++index) {
+                add_item(section.item_name(index), section.is_item_selected(index));
+            }
+        }
+
+        /**
+         * @brief Write to path through a temporary file, so readers never see half a snapshot
+         *
+         * The data is synced before the rename, so after a crash path holds
+         * either the old or the new snapshot.
+         */
+        [[nodiscard]] bool write(const std::string &path) const;
+
+        [[nodiscard]] size_t section_count() const { return sections_.size(); }
+
+    private:
+        struct PendingSection {
+            uint64_t name_hash = 0;
+            std::vector<uint64_t> hashes;
+            std::vector<uint64_t> bits;
+            uint32_t selected = 0;
+        };
+
+        std::vector<PendingSection> sections_;
+    };
+
+    /**
+     * @brief Memory-mapped snapshot written by SnapshotWriter
+     *
+     * Opening validates the header and every offset but reads no item data;
+     * apply() then touches each section's arrays once.
+     */
+    class SnapshotReader {
+    public:
+        static constexpr uint32_t version = 1;
+
+        /**
+         * @brief Stored state of one section
+         *
+         * Items are looked up by position first: while the live section holds
+         * the same names in the same order, no hash table is involved. The
+         * first mismatch builds a table over the stored hashes.
+         */
+        class StoredSection {
+        public:
+            [[nodiscard]] uint64_t section_hash() const { return section_hash_; }
+            [[nodiscard]] size_t size() const { return count_; }
+            [[nodiscard]] size_t selected_count() const { return selected_; }
+
+            [[nodiscard]] uint64_t hash_at(size_t position) const;
+            [[nodiscard]] bool bit_at(size_t position) const;
+
+            /**
+             * @brief Stored state of the item named hash, expected at index
+             *
+             * @return nullopt if the snapshot has no such item
+             */
+            std::optional<bool> lookup(size_t index, uint64_t hash);
+
+        private:
+            friend class SnapshotReader;
+
+            uint64_t section_hash_ = 0;
+            const unsigned char *hashes_ = nullptr;
+            const unsigned char *bits_ = nullptr;
+            uint32_t count_ = 0;
+            uint32_t selected_ = 0;
+            std::vector<uint32_t> table_; ///< Open addressing over stored positions, + 1; built on demand
+
+            void build_table();
+        };
+
+        /**
+         * @brief Map and validate a snapshot
+         *
+         * @return nullptr if the file is missing, truncated, of another version or not a snapshot
+         */
+        static std::unique_ptr<SnapshotReader> open(const std::string &path);
+
+        ~SnapshotReader();
+
+        SnapshotReader(const SnapshotReader &) = delete;
+        SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+        [[nodiscard]] size_t section_count() const { return section_count_; }
+
+        /**
+         * @brief Stored state of the i-th section in file order
+         */
+        [[nodiscard]] StoredSection section(size_t i) const;
+
+        /**
+         * @brief Stored state of the section with this name, if any
+         */
+        [[nodiscard]] std::optional<StoredSection> find(std::string_view section_name) const;
+
+        /**
+         * @brief Set the selection of every item of section found in the snapshot
+         *
+         * Runs as one batch and bypasses constraints; items missing from the
+         * snapshot keep their state.
+         *
+         * @return Number of items found in the snapshot
+         */
+        template <typename SectionT>
+        size_t apply(SectionT &section) const {
+            auto stored = find(section.name);
+            if (!stored) {
+                return 0;
+            }
+
+            size_t found = 0;
+            section.begin_batch();
+            for (size_t index = 0; index < section.size(); ++index) {
+                if (const auto selected = stored->lookup(index, snapshot_hash(section.item_name(index)))) {
+                    section.restore_item_selected(index, *selected);
+                    ++found;
+                }
+            }
+            section.end_batch();
+            return found;
+        }
+
+    private:
+        SnapshotReader() = default;
+
+        [[nodiscard]] bool validate() const;
+
+        const unsigned char *data_ = nullptr;
+        size_t length_ = 0;
+        uint32_t section_count_ = 0;
+#ifdef _WIN32
+        std::vector<unsigned char> buffer_; ///< No mmap here, the file is read into memory instead
+#endif
+    };
+
+} // namespace tui
@@ -144,6 +144,25 @@ namespace tui {
         static void set_canonical_mode(bool enable);
         static void flush();
 
+        /**
+         * @brief Descriptor keystrokes are read from (POSIX only)
+         *
+         * By default this is stdin, or /dev/tty when stdin is not a terminal
+         * (e.g. `producer | mytool`), so stdin stays free for streamed data.
+         * Pass -1 to go back to that automatic choice. Takes effect on the
+         * next init_terminal().
+         */
+        static void set_input_fd(int fd);
+        [[nodiscard]] static int get_input_fd();
+
+        /**
+         * @brief Whether an interactive session is possible
+         *
+         * Needs stdout to be a terminal and keystrokes to come from one: stdin,
+         * the descriptor given to set_input_fd(), or /dev/tty.
+         */
+        [[nodiscard]] static bool has_terminal();
+
     private:
 #ifdef _WIN32
         static HANDLE hConsole;
@@ -153,6 +172,9 @@ namespace tui {
 #else
         static struct termios original_termios;
         static bool termios_saved;
+        static int requested_input_fd; ///< -1 = automatic
+        static int input_fd;
+        static bool input_fd_owned;    ///< input_fd is our own /dev/tty descriptor
 #endif
         static Key parse_escape_sequence();
         static void init_platform_terminal();
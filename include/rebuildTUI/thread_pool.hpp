@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tui {
+
+    /**
+     * @brief Fixed set of worker threads for data-parallel loops
+     *
+     * parallel_for() splits [0, count) into chunks of `grain` indices that the
+     * workers and the calling thread claim from a shared counter, so uneven
+     * chunks balance themselves. One loop runs at a time; a parallel_for()
+     * issued from inside a loop body runs serially on the calling thread.
+     */
+    class ThreadPool {
+    public:
+        using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+        /**
+         * @param threads Threads taking part in a loop, including the caller
+         */
+        explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Process-wide pool sized to the hardware, started on first use
+         */
+        static ThreadPool &shared();
+
+        [[nodiscard]] size_t concurrency() const { return workers_.size() + 1; }
+
+        /**
+         * @brief Call fn on disjoint chunks covering [0, count) and wait for all of them
+         *
+         * The first exception thrown by fn stops handing out chunks and is
+         * rethrown here once every thread has finished.
+         */
+        void parallel_for(size_t count, size_t grain, const RangeFn &fn);
+
+    private:
+        struct Job;
+
+        void work(const std::stop_token &stop);
+
+        std::mutex run_mutex_; ///< Serializes parallel_for() callers
+        std::mutex mutex_;
+        std::condition_variable_any wake_;
+        std::condition_variable done_;
+        Job *job_ = nullptr;
+        uint64_t generation_ = 0;
+        size_t busy_ = 0;
+        std::vector<std::jthread> workers_; ///< Last, so they stop before the state above goes away
+    };
+
+} // namespace tui
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "background_worker.hpp"
+#include "handle.hpp"
+#include "item_source.hpp"
+
+namespace tui {
+
+    /**
+     * @brief Case-insensitive substring index over the item names of many sections
+     *
+     * Each section gets its own segment mapping every trigram of its item
+     * names to the sorted indices of the items containing it, so sections can
+     * be replaced or dropped independently. Segments are built on a background
+     * thread; until a newer one is ready, queries use the previous one.
+     *
+     * candidates() may return items whose name contains all trigrams of the
+     * query but not the query itself, and items that have changed since they
+     * were indexed; callers verify hits against the live section.
+     */
+    class TrigramIndex {
+    public:
+        static constexpr size_t min_query_length = 3;
+
+        struct Hit {
+            SectionHandle section;
+            uint32_t item; ///< Storage index at the time the section was indexed
+        };
+
+        /**
+         * @brief Queue (re)indexing of a section's names
+         *
+         * @param revision Content revision of the section; older builds still queued are skipped
+         * @param names Rows to index; read on the background thread, so it must not change.
+         *              Ready rows of a source without concurrent_reads() are copied here first
+         */
+        void update(SectionHandle section, uint64_t revision, std::shared_ptr<const ItemSource> names);
+        void update(SectionHandle section, uint64_t revision, std::vector<std::string> names);
+        void remove(SectionHandle section);
+        void clear();
+
+        /**
+         * @brief Revision last passed to update() for the section, if any
+         */
+        [[nodiscard]] std::optional<uint64_t> queued_revision(SectionHandle section) const;
+
+        /**
+         * @brief Whether segments are still being built
+         */
+        [[nodiscard]] bool building() const { return worker_.pending() > 0 || building_; }
+
+        /**
+         * @brief Items containing every trigram of query, at most limit of them
+         *
+         * Empty for queries shorter than min_query_length.
+         */
+        [[nodiscard]] std::vector<Hit> candidates(std::string_view query, size_t limit) const;
+
+    private:
+        using Postings = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+        void build(SectionHandle section, uint64_t revision, const std::shared_ptr<const ItemSource> &names);
+
+        mutable std::mutex mutex_;
+        std::vector<std::pair<SectionHandle, std::shared_ptr<const Postings>>> segments_;
+        std::vector<std::pair<SectionHandle, uint64_t>> queued_;
+        std::atomic<bool> building_{false};
+        BackgroundWorker worker_; ///< Last, so a running build finishes before the segments go away
+    };
+
+} // namespace tui
@@ -0,0 +1,240 @@
+#include "attribute_index.hpp"
+
+#include <algorithm>
+
+namespace tui {
+
+    Query Query::tag(std::string key, std::string value) {
+        return Query(Node{Kind::tag, std::move(key), std::move(value), {}, false});
+    }
+
+    Query Query::has(std::string key) { return Query(Node{Kind::has, std::move(key), {}, {}, false}); }
+
+    Query Query::selected() { return Query(Node{Kind::selected, {}, {}, {}, true}); }
+
+    Query Query::combine(const Kind kind, Query a, Query b) {
+        Node node{kind, {}, {}, {}, a.uses_selection() || b.uses_selection()};
+        // flatten chains like a && b && c into one node
+        for (Query *part : {&a, &b}) {
+            if (part->kind() == kind) {
+                node.children.insert(node.children.end(), part->node_->children.begin(), part->node_->children.end());
+            } else {
+                node.children.push_back(std::move(*part));
+            }
+        }
+        return Query(std::move(node));
+    }
+
+    Query operator&&(Query a, Query b) {
+        if (a.kind() == Query::Kind::all) {
+            return b;
+        }
+        if (b.kind() == Query::Kind::all) {
+            return a;
+        }
+        return Query::combine(Query::Kind::all_of, std::move(a), std::move(b));
+    }
+
+    Query operator||(Query a, Query b) {
+        if (a.kind() == Query::Kind::all || b.kind() == Query::Kind::all) {
+            return Query();
+        }
+        return Query::combine(Query::Kind::any_of, std::move(a), std::move(b));
+    }
+
+    Query operator!(Query query) {
+        if (query.kind() == Query::Kind::negate) {
+            return query.node_->children.front();
+        }
+        const bool uses_selection = query.uses_selection();
+        return Query(Query::Node{Query::Kind::negate, {}, {}, {std::move(query)}, uses_selection});
+    }
+
+    bool AttributeIndex::set(const uint32_t item, const std::string_view key, const std::string_view value) {
+        auto key_it = values_.find(key);
+        if (key_it == values_.end()) {
+            key_it = values_.emplace(std::string(key), Values{}).first;
+        }
+
+        Values &values = key_it->second;
+        for (auto it = values.begin(); it != values.end(); ++it) {
+            if (!it->second.contains(item)) {
+                continue;
+            }
+            if (it->first == value) {
+                return false;
+            }
+            it->second.remove(item);
+            if (it->second.empty()) {
+                values.erase(it);
+            }
+            break;
+        }
+
+        auto value_it = values.find(value);
+        if (value_it == values.end()) {
+            value_it = values.emplace(std::string(value), Bitmap{}).first;
+        }
+        value_it->second.add(item);
+        return true;
+    }
+
+    bool AttributeIndex::erase(const uint32_t item, const std::string_view key) {
+        const auto key_it = values_.find(key);
+        if (key_it == values_.end()) {
+            return false;
+        }
+        Values &values = key_it->second;
+        const auto it = std::ranges::find_if(values, [item](const auto &entry) { return entry.second.contains(item); });
+        if (it == values.end()) {
+            return false;
+        }
+        it->second.remove(item);
+        if (it->second.empty()) {
+            values.erase(it);
+            if (values.empty()) {
+                values_.erase(key_it);
+            }
+        }
+        return true;
+    }
+
+    void AttributeIndex::erase_item(const uint32_t item) {
+        for (const std::string_view key : keys()) {
+            erase(item, key);
+        }
+    }
+
+    std::optional<std::string_view> AttributeIndex::get(const uint32_t item, const std::string_view key) const {
+        const auto key_it = values_.find(key);
+        if (key_it == values_.end()) {
+            return std::nullopt;
+        }
+        for (const auto &[value, items] : key_it->second) {
+            if (items.contains(item)) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    const Bitmap *AttributeIndex::items_with(const std::string_view key, const std::string_view value) const {
+        const auto key_it = values_.find(key);
+        if (key_it == values_.end()) {
+            return nullptr;
+        }
+        const auto value_it = key_it->second.find(value);
+        return value_it != key_it->second.end() ? &value_it->second : nullptr;
+    }
+
+    std::vector<std::string_view> AttributeIndex::keys() const {
+        std::vector<std::string_view> keys;
+        keys.reserve(values_.size());
+        for (const auto &[key, values] : values_) {
+            keys.emplace_back(key);
+        }
+        return keys;
+    }
+
+    void AttributeIndex::for_each_bitmap(const std::function<void(Bitmap &)> &fn) {
+        for (auto &[key, values] : values_) {
+            for (auto &[value, items] : values) {
+                fn(items);
+            }
+        }
+    }
+
+    void AttributeIndex::relocate(const uint32_t from, const uint32_t to) {
+        erase_item(to);
+        for_each_bitmap([from, to](Bitmap &items) { items.relocate(from, to); });
+    }
+
+    void AttributeIndex::permute(const std::span<const uint32_t> old_index) {
+        std::vector<uint32_t> new_index(old_index.size());
+        for (uint32_t index = 0; index < old_index.size(); ++index) {
+            new_index[old_index[index]] = index;
+        }
+        for_each_bitmap([&new_index](Bitmap &items) {
+            Bitmap moved;
+            items.for_each([&](const uint32_t item) {
+                if (item < new_index.size()) {
+                    moved.add(new_index[item]);
+                }
+            });
+            items = std::move(moved);
+        });
+    }
+
+    Bitmap AttributeIndex::evaluate(const Query &query, const uint32_t universe, const Bitmap &selected) const {
+        switch (query.kind()) {
+        case Query::Kind::all:
+            return Bitmap::range(0, universe);
+        case Query::Kind::selected:
+            return selected;
+        case Query::Kind::tag: {
+            const Bitmap *items = items_with(query.node_->key, query.node_->value);
+            return items ? *items : Bitmap{};
+        }
+        case Query::Kind::has: {
+            Bitmap result;
+            if (const auto key_it = values_.find(query.node_->key); key_it != values_.end()) {
+                for (const auto &[value, items] : key_it->second) {
+                    result |= items;
+                }
+            }
+            return result;
+        }
+        case Query::Kind::all_of: {
+            // negated terms are subtracted, so "a && !b" never materialises the complement of b
+            std::optional<Bitmap> result;
+            std::vector<const Query *> excluded;
+            for (const Query &child : query.node_->children) {
+                if (child.kind() == Query::Kind::negate) {
+                    excluded.push_back(&child.node_->children.front());
+                } else if (!result) {
+                    result = evaluate(child, universe, selected);
+                } else if (!result->empty()) {
+                    *result &= evaluate(child, universe, selected);
+                }
+            }
+            if (!result) {
+                result = Bitmap::range(0, universe);
+            }
+            for (const Query *child : excluded) {
+                if (result->empty()) {
+                    break;
+                }
+                *result -= evaluate(*child, universe, selected);
+            }
+            return std::move(*result);
+        }
+        case Query::Kind::any_of: {
+            Bitmap result;
+            for (const Query &child : query.node_->children) {
+                result |= evaluate(child, universe, selected);
+            }
+            return result;
+        }
+        case Query::Kind::negate:
+            return Bitmap::range(0, universe) - evaluate(query.node_->children.front(), universe, selected);
+        }
+        return {};
+    }
+
+    std::vector<AttributeIndex::Facet> AttributeIndex::facet_counts(const std::string_view key,
+                                                                    const Bitmap &within) const {
+        std::vector<Facet> facets;
+        const auto key_it = values_.find(key);
+        if (key_it == values_.end()) {
+            return facets;
+        }
+        facets.reserve(key_it->second.size());
+        for (const auto &[value, items] : key_it->second) {
+            if (const size_t count = Bitmap::and_cardinality(items, within); count > 0) {
+                facets.push_back({value, count});
+            }
+        }
+        return facets;
+    }
+
+} // namespace tui
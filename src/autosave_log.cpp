@@ -0,0 +1,293 @@
+#include "autosave_log.hpp"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace tui {
+    namespace {
+        constexpr char magic[8] = {'R', 'T', 'U', 'I', 'L', 'O', 'G', '1'};
+        constexpr size_t record_size = 24; ///< u64 section hash, u64 item hash, u32 selected, u32 check
+
+        uint64_t load_u64(const unsigned char *data) {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+
+        uint32_t load_u32(const unsigned char *data) {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+
+        template <typename T>
+        void store(std::vector<unsigned char> &out, T value) {
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            const size_t at = out.size();
+            out.resize(at + sizeof(value));
+            std::memcpy(out.data() + at, &value, sizeof(value));
+        }
+
+        // a torn or zeroed record fails this
+        uint32_t record_check(const uint64_t section_hash, const uint64_t item_hash, const uint32_t selected) {
+            const uint64_t mixed = ((section_hash ^ std::rotl(item_hash, 29) ^ selected) + 1) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<uint32_t>(mixed >> 32);
+        }
+
+#ifdef _WIN32
+        int open_log(const std::string &path) {
+            return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+        }
+        bool write_log(const int fd, const unsigned char *data, const size_t size) {
+            for (size_t done = 0; done < size;) {
+                const int n = _write(fd, data + done, static_cast<unsigned>(size - done));
+                if (n <= 0) {
+                    return false;
+                }
+                done += static_cast<size_t>(n);
+            }
+            return true;
+        }
+        bool sync_log(const int fd) { return _commit(fd) == 0; }
+        bool truncate_log(const int fd, const size_t size) { return _chsize_s(fd, static_cast<long long>(size)) == 0; }
+        void close_log(const int fd) { _close(fd); }
+#else
+        int open_log(const std::string &path) {
+            return ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        }
+        bool write_log(const int fd, const unsigned char *data, const size_t size) {
+            for (size_t done = 0; done < size;) {
+                const ssize_t n = ::write(fd, data + done, size - done);
+                if (n <= 0) {
+                    return false;
+                }
+                done += static_cast<size_t>(n);
+            }
+            return true;
+        }
+        bool sync_log(const int fd) { return fdatasync(fd) == 0; }
+        bool truncate_log(const int fd, const size_t size) { return ftruncate(fd, static_cast<off_t>(size)) == 0; }
+        void close_log(const int fd) { close(fd); }
+#endif
+
+        // empties the log and starts it over with just the header
+        bool reset_log(const int fd) {
+            return truncate_log(fd, 0) &&
+                   write_log(fd, reinterpret_cast<const unsigned char *>(magic), sizeof(magic)) && sync_log(fd);
+        }
+    } // namespace
+
+    std::unique_ptr<AutosaveLog> AutosaveLog::open(const std::string &path, const Options options) {
+        std::unique_ptr<AutosaveLog> log(new AutosaveLog(path, options));
+        log->snapshot_ = SnapshotReader::open(path);
+
+        std::vector<unsigned char> data;
+        if (std::ifstream file(log->log_path(), std::ios::binary); file) {
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!data.empty() && (data.size() < sizeof(magic) || std::memcmp(data.data(), magic, sizeof(magic)) != 0)) {
+            // not ours, leave it alone
+            return nullptr;
+        }
+
+        size_t valid = data.empty() ? 0 : sizeof(magic);
+        for (; valid + record_size <= data.size(); valid += record_size) {
+            const unsigned char *record = data.data() + valid;
+            const uint64_t section_hash = load_u64(record);
+            const uint64_t item_hash = load_u64(record + 8);
+            const uint32_t selected = load_u32(record + 16);
+            if (selected > 1 || load_u32(record + 20) != record_check(section_hash, item_hash, selected)) {
+                break;
+            }
+            log->logged_[section_hash][item_hash] = selected != 0;
+            ++log->logged_records_;
+        }
+
+        log->latest_ = log->logged_;
+
+        log->fd_ = open_log(log->log_path());
+        if (log->fd_ < 0) {
+            return nullptr;
+        }
+        if (valid == 0) {
+            if (!reset_log(log->fd_)) {
+                return nullptr;
+            }
+        } else if (valid != data.size() && (!truncate_log(log->fd_, valid) || !sync_log(log->fd_))) {
+            return nullptr;
+        }
+        return log;
+    }
+
+    AutosaveLog::~AutosaveLog() {
+        if (thread_.joinable()) {
+            thread_.request_stop();
+            wake_.notify_all();
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            close_log(fd_);
+        }
+    }
+
+    bool AutosaveLog::covers(const std::string_view section_name) const {
+        return (snapshot_ && snapshot_->find(section_name)) || latest_.contains(snapshot_hash(section_name));
+    }
+
+    void AutosaveLog::enqueue(std::vector<Record> records) {
+        if (!thread_.joinable()) {
+            thread_ = std::jthread([this](const std::stop_token &stop) { run(stop); });
+        }
+        {
+            std::lock_guard lock(mutex_);
+            appended_ += records.size();
+            if (queue_.empty()) {
+                queue_ = std::move(records);
+            } else {
+                queue_.insert(queue_.end(), records.begin(), records.end());
+            }
+        }
+        wake_.notify_one();
+    }
+
+    void AutosaveLog::flush() {
+        std::unique_lock lock(mutex_);
+        const uint64_t target = appended_;
+        if (durable_ >= target) {
+            return;
+        }
+        flush_requested_ = true;
+        wake_.notify_one();
+        synced_.wait(lock, [&] { return durable_ >= target; });
+    }
+
+    bool AutosaveLog::healthy() const {
+        std::lock_guard lock(mutex_);
+        return healthy_;
+    }
+
+    void AutosaveLog::run(const std::stop_token &stop) {
+        auto last_sync = std::chrono::steady_clock::time_point{};
+        while (true) {
+            std::vector<Record> batch;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, stop, [this] { return !queue_.empty(); });
+                // let a burst of changes gather into one write and one sync
+                wake_.wait_until(lock, stop, last_sync + options_.sync_interval, [this] { return flush_requested_; });
+                flush_requested_ = false;
+                batch.swap(queue_);
+            }
+
+            bool ok = batch.empty() || persist(batch);
+            last_sync = std::chrono::steady_clock::now();
+            // fold on the way out too, so the next start reads a single snapshot
+            const bool stopping = stop.stop_requested();
+            if (stopping ? logged_records_ > 0 : logged_records_ >= options_.compact_after) {
+                ok = compact() && ok;
+            }
+
+            {
+                std::lock_guard lock(mutex_);
+                durable_ += batch.size();
+                healthy_ = healthy_ && ok;
+            }
+            synced_.notify_all();
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+    bool AutosaveLog::persist(const std::vector<Record> &records) {
+        std::vector<unsigned char> out;
+        out.reserve(records.size() * record_size);
+        for (const auto &[section_hash, item_hash, selected] : records) {
+            const uint32_t state = selected ? 1 : 0;
+            store(out, section_hash);
+            store(out, item_hash);
+            store(out, state);
+            store(out, record_check(section_hash, item_hash, state));
+            logged_[section_hash][item_hash] = selected;
+        }
+        logged_records_ += records.size();
+        return write_log(fd_, out.data(), out.size()) && sync_log(fd_);
+    }
+
+    bool AutosaveLog::compact() {
+        SnapshotWriter writer;
+        std::unordered_set<uint64_t> folded_sections;
+        const auto append_new = [&](const std::unordered_map<uint64_t, bool> &items,
+                                    const std::unordered_set<uint64_t> &stored) {
+            for (const auto &[item_hash, selected] : items) {
+                if (!stored.contains(item_hash)) {
+                    writer.add_hashed_item(item_hash, selected);
+                }
+            }
+        };
+
+        // the previous snapshot, in its order, with logged states laid over it
+        if (const auto previous = SnapshotReader::open(path_)) {
+            for (size_t i = 0; i < previous->section_count(); ++i) {
+                const auto section = previous->section(i);
+                const auto logged = logged_.find(section.section_hash());
+                if (logged == logged_.end()) {
+                    writer.begin_hashed_section(section.section_hash(), section.size());
+                    for (size_t position = 0; position < section.size(); ++position) {
+                        writer.add_hashed_item(section.hash_at(position), section.bit_at(position));
+                    }
+                    continue;
+                }
+
+                writer.begin_hashed_section(section.section_hash(), section.size() + logged->second.size());
+                std::unordered_set<uint64_t> stored;
+                for (size_t position = 0; position < section.size(); ++position) {
+                    const uint64_t item_hash = section.hash_at(position);
+                    const auto item = logged->second.find(item_hash);
+                    writer.add_hashed_item(item_hash, item != logged->second.end() ? item->second
+                                                                                   : section.bit_at(position));
+                    if (item != logged->second.end()) {
+                        stored.insert(item_hash);
+                    }
+                }
+                append_new(logged->second, stored);
+                folded_sections.insert(section.section_hash());
+            }
+        }
+        for (const auto &[section_hash, items] : logged_) {
+            if (!folded_sections.contains(section_hash)) {
+                writer.begin_hashed_section(section_hash, items.size());
+                append_new(items, {});
+            }
+        }
+
+        // the log stays intact until the snapshot holding its records is in place
+        if (!writer.write(path_) || !reset_log(fd_)) {
+            return false;
+        }
+        logged_.clear();
+        logged_records_ = 0;
+        return true;
+    }
+
+} // namespace tui
@@ -0,0 +1,368 @@
+#include "bitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace tui {
+    namespace {
+        constexpr size_t bitset_words = 65536 / 64;
+
+        bool test(const std::vector<uint64_t> &bits, const uint16_t low) { return (bits[low >> 6] >> (low & 63)) & 1; }
+
+        size_t popcount(const std::vector<uint64_t> &bits) {
+            size_t count = 0;
+            for (const uint64_t word : bits) {
+                count += static_cast<size_t>(std::popcount(word));
+            }
+            return count;
+        }
+    } // namespace
+
+    Bitmap Bitmap::range(const uint32_t first, const uint32_t last) {
+        Bitmap result;
+        for (uint64_t begin = first; begin < last;) {
+            const auto key = static_cast<uint16_t>(begin >> 16);
+            const uint64_t end = std::min<uint64_t>(last, (static_cast<uint64_t>(key) + 1) << 16);
+
+            Container container;
+            container.key = key;
+            container.cardinality = static_cast<uint32_t>(end - begin);
+            container.bits.assign(bitset_words, 0);
+            for (uint64_t value = begin; value < end; ++value) {
+                container.bits[(value & 0xFFFF) >> 6] |= uint64_t{1} << (value & 63);
+            }
+            normalize(container);
+            result.containers_.push_back(std::move(container));
+            begin = end;
+        }
+        return result;
+    }
+
+    Bitmap::Container *Bitmap::find(const uint16_t key) {
+        const auto it = std::ranges::lower_bound(containers_, key, {}, &Container::key);
+        return (it != containers_.end() && it->key == key) ? &*it : nullptr;
+    }
+
+    const Bitmap::Container *Bitmap::find(const uint16_t key) const {
+        const auto it = std::ranges::lower_bound(containers_, key, {}, &Container::key);
+        return (it != containers_.end() && it->key == key) ? &*it : nullptr;
+    }
+
+    bool Bitmap::add(const uint32_t value) {
+        const auto key = static_cast<uint16_t>(value >> 16);
+        const auto low = static_cast<uint16_t>(value);
+
+        auto it = std::ranges::lower_bound(containers_, key, {}, &Container::key);
+        if (it == containers_.end() || it->key != key) {
+            it = containers_.insert(it, Container{});
+            it->key = key;
+        }
+
+        if (it->is_bitset()) {
+            uint64_t &word = it->bits[low >> 6];
+            const uint64_t mask = uint64_t{1} << (low & 63);
+            if (word & mask) {
+                return false;
+            }
+            word |= mask;
+        } else {
+            const auto at = std::ranges::lower_bound(it->values, low);
+            if (at != it->values.end() && *at == low) {
+                return false;
+            }
+            it->values.insert(at, low);
+        }
+        ++it->cardinality;
+        normalize(*it);
+        return true;
+    }
+
+    bool Bitmap::remove(const uint32_t value) {
+        const auto key = static_cast<uint16_t>(value >> 16);
+        const auto low = static_cast<uint16_t>(value);
+
+        const auto it = std::ranges::lower_bound(containers_, key, {}, &Container::key);
+        if (it == containers_.end() || it->key != key) {
+            return false;
+        }
+
+        if (it->is_bitset()) {
+            uint64_t &word = it->bits[low >> 6];
+            const uint64_t mask = uint64_t{1} << (low & 63);
+            if (!(word & mask)) {
+                return false;
+            }
+            word &= ~mask;
+        } else {
+            const auto at = std::ranges::lower_bound(it->values, low);
+            if (at == it->values.end() || *at != low) {
+                return false;
+            }
+            it->values.erase(at);
+        }
+
+        if (--it->cardinality == 0) {
+            containers_.erase(it);
+        } else {
+            normalize(*it);
+        }
+        return true;
+    }
+
+    bool Bitmap::contains(const uint32_t value) const {
+        const Container *container = find(static_cast<uint16_t>(value >> 16));
+        if (container == nullptr) {
+            return false;
+        }
+        const auto low = static_cast<uint16_t>(value);
+        return container->is_bitset() ? test(container->bits, low) : std::ranges::binary_search(container->values, low);
+    }
+
+    void Bitmap::relocate(const uint32_t from, const uint32_t to) {
+        if (from == to) {
+            return;
+        }
+        remove(to);
+        if (remove(from)) {
+            add(to);
+        }
+    }
+
+    size_t Bitmap::cardinality() const {
+        size_t count = 0;
+        for (const auto &container : containers_) {
+            count += container.cardinality;
+        }
+        return count;
+    }
+
+    std::vector<uint32_t> Bitmap::to_vector() const {
+        std::vector<uint32_t> values;
+        values.reserve(cardinality());
+        for_each([&values](const uint32_t value) { values.push_back(value); });
+        return values;
+    }
+
+    bool Bitmap::operator==(const Bitmap &other) const {
+        return std::ranges::equal(containers_, other.containers_, [](const Container &a, const Container &b) {
+            return a.key == b.key && a.cardinality == b.cardinality && a.values == b.values && a.bits == b.bits;
+        });
+    }
+
+    void Bitmap::to_bitset(Container &container) {
+        container.bits.assign(bitset_words, 0);
+        for (const uint16_t low : container.values) {
+            container.bits[low >> 6] |= uint64_t{1} << (low & 63);
+        }
+        container.values.clear();
+        container.values.shrink_to_fit();
+    }
+
+    void Bitmap::to_array(Container &container) {
+        container.values.clear();
+        container.values.reserve(container.cardinality);
+        for (size_t word = 0; word < container.bits.size(); ++word) {
+            for (uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1) {
+                container.values.push_back(static_cast<uint16_t>(word * 64 + std::countr_zero(bits)));
+            }
+        }
+        container.bits.clear();
+        container.bits.shrink_to_fit();
+    }
+
+    void Bitmap::normalize(Container &container) {
+        if (!container.is_bitset() && container.cardinality > max_array_size) {
+            to_bitset(container);
+        } else if (container.is_bitset() && container.cardinality <= max_array_size) {
+            to_array(container);
+        }
+    }
+
+    Bitmap::Container Bitmap::intersect(const Container &a, const Container &b) {
+        Container result;
+        result.key = a.key;
+        if (a.is_bitset() && b.is_bitset()) {
+            result.bits.resize(bitset_words);
+            for (size_t word = 0; word < bitset_words; ++word) {
+                result.bits[word] = a.bits[word] & b.bits[word];
+            }
+            result.cardinality = static_cast<uint32_t>(popcount(result.bits));
+        } else if (a.is_bitset() || b.is_bitset()) {
+            const Container &array = a.is_bitset() ? b : a;
+            const Container &bitset = a.is_bitset() ? a : b;
+            for (const uint16_t low : array.values) {
+                if (test(bitset.bits, low)) {
+                    result.values.push_back(low);
+                }
+            }
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        } else {
+            std::ranges::set_intersection(a.values, b.values, std::back_inserter(result.values));
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        }
+        normalize(result);
+        return result;
+    }
+
+    Bitmap::Container Bitmap::unite(const Container &a, const Container &b) {
+        Container result;
+        result.key = a.key;
+        if (!a.is_bitset() && !b.is_bitset()) {
+            result.values.reserve(a.values.size() + b.values.size());
+            std::ranges::set_union(a.values, b.values, std::back_inserter(result.values));
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+            normalize(result);
+            return result;
+        }
+
+        result.bits = a.is_bitset() ? a.bits : b.bits;
+        const Container &other = a.is_bitset() ? b : a;
+        if (other.is_bitset()) {
+            for (size_t word = 0; word < bitset_words; ++word) {
+                result.bits[word] |= other.bits[word];
+            }
+        } else {
+            for (const uint16_t low : other.values) {
+                result.bits[low >> 6] |= uint64_t{1} << (low & 63);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(popcount(result.bits));
+        return result;
+    }
+
+    Bitmap::Container Bitmap::subtract(const Container &a, const Container &b) {
+        Container result;
+        result.key = a.key;
+        if (a.is_bitset()) {
+            result.bits = a.bits;
+            if (b.is_bitset()) {
+                for (size_t word = 0; word < bitset_words; ++word) {
+                    result.bits[word] &= ~b.bits[word];
+                }
+            } else {
+                for (const uint16_t low : b.values) {
+                    result.bits[low >> 6] &= ~(uint64_t{1} << (low & 63));
+                }
+            }
+            result.cardinality = static_cast<uint32_t>(popcount(result.bits));
+        } else if (b.is_bitset()) {
+            for (const uint16_t low : a.values) {
+                if (!test(b.bits, low)) {
+                    result.values.push_back(low);
+                }
+            }
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        } else {
+            std::ranges::set_difference(a.values, b.values, std::back_inserter(result.values));
+            result.cardinality = static_cast<uint32_t>(result.values.size());
+        }
+        normalize(result);
+        return result;
+    }
+
+    size_t Bitmap::intersect_count(const Container &a, const Container &b) {
+        if (a.is_bitset() && b.is_bitset()) {
+            size_t count = 0;
+            for (size_t word = 0; word < bitset_words; ++word) {
+                count += static_cast<size_t>(std::popcount(a.bits[word] & b.bits[word]));
+            }
+            return count;
+        }
+        if (a.is_bitset() || b.is_bitset()) {
+            const Container &array = a.is_bitset() ? b : a;
+            const Container &bitset = a.is_bitset() ? a : b;
+            return static_cast<size_t>(
+                std::ranges::count_if(array.values, [&bitset](const uint16_t low) { return test(bitset.bits, low); }));
+        }
+
+        size_t count = 0;
+        auto left = a.values.begin();
+        auto right = b.values.begin();
+        while (left != a.values.end() && right != b.values.end()) {
+            if (*left < *right) {
+                ++left;
+            } else if (*right < *left) {
+                ++right;
+            } else {
+                ++count;
+                ++left;
+                ++right;
+            }
+        }
+        return count;
+    }
+
+    Bitmap &Bitmap::operator&=(const Bitmap &other) {
+        std::vector<Container> result;
+        auto left = containers_.begin();
+        auto right = other.containers_.begin();
+        while (left != containers_.end() && right != other.containers_.end()) {
+            if (left->key < right->key) {
+                ++left;
+            } else if (right->key < left->key) {
+                ++right;
+            } else {
+                if (Container both = intersect(*left, *right); both.cardinality > 0) {
+                    result.push_back(std::move(both));
+                }
+                ++left;
+                ++right;
+            }
+        }
+        containers_ = std::move(result);
+        return *this;
+    }
+
+    Bitmap &Bitmap::operator|=(const Bitmap &other) {
+        std::vector<Container> result;
+        result.reserve(containers_.size() + other.containers_.size());
+        auto left = containers_.begin();
+        auto right = other.containers_.begin();
+        while (left != containers_.end() || right != other.containers_.end()) {
+            if (right == other.containers_.end() || (left != containers_.end() && left->key < right->key)) {
+                result.push_back(std::move(*left++));
+            } else if (left == containers_.end() || right->key < left->key) {
+                result.push_back(*right++);
+            } else {
+                result.push_back(unite(*left++, *right++));
+            }
+        }
+        containers_ = std::move(result);
+        return *this;
+    }
+
+    Bitmap &Bitmap::operator-=(const Bitmap &other) {
+        std::vector<Container> result;
+        result.reserve(containers_.size());
+        auto right = other.containers_.begin();
+        for (auto &container : containers_) {
+            while (right != other.containers_.end() && right->key < container.key) {
+                ++right;
+            }
+            if (right == other.containers_.end() || right->key != container.key) {
+                result.push_back(std::move(container));
+            } else if (Container rest = subtract(container, *right); rest.cardinality > 0) {
+                result.push_back(std::move(rest));
+            }
+        }
+        containers_ = std::move(result);
+        return *this;
+    }
+
+    size_t Bitmap::and_cardinality(const Bitmap &a, const Bitmap &b) {
+        size_t count = 0;
+        auto left = a.containers_.begin();
+        auto right = b.containers_.begin();
+        while (left != a.containers_.end() && right != b.containers_.end()) {
+            if (left->key < right->key) {
+                ++left;
+            } else if (right->key < left->key) {
+                ++right;
+            } else {
+                count += intersect_count(*left++, *right++);
+            }
+        }
+        return count;
+    }
+
+} // namespace tui
@@ -0,0 +1,237 @@
+#include "constraint_graph.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <format>
+
+namespace tui {
+
+    ConstraintGraph::Adjacency ConstraintGraph::Adjacency::pack(const size_t node_count,
+                                                                std::vector<std::pair<uint32_t, uint32_t>> edges) {
+        std::ranges::sort(edges);
+        const auto duplicates = std::ranges::unique(edges);
+        edges.erase(duplicates.begin(), duplicates.end());
+
+        Adjacency adjacency;
+        adjacency.offsets.assign(node_count + 1, 0);
+        adjacency.targets.reserve(edges.size());
+        for (const auto &[from, to] : edges) {
+            ++adjacency.offsets[from + 1];
+            adjacency.targets.push_back(to);
+        }
+        for (size_t node = 0; node < node_count; ++node) {
+            adjacency.offsets[node + 1] += adjacency.offsets[node];
+        }
+        return adjacency;
+    }
+
+    std::span<const uint32_t> ConstraintGraph::Adjacency::operator[](const uint32_t node) const {
+        if (node + 1 >= offsets.size()) {
+            return {};
+        }
+        return std::span(targets).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+    }
+
+    std::optional<uint32_t> ConstraintGraph::node_of(const ItemHandle item) const {
+        const auto it = node_of_slot_.find(item.slot);
+        if (it == node_of_slot_.end() || nodes_[it->second] != item) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::optional<std::vector<ConstraintGraph::Assignment>>
+    ConstraintGraph::propagate(const ItemHandle root, const bool selected, const StateFn &state) const {
+        std::vector<Assignment> changes{{root, selected}};
+        const auto root_node = node_of(root);
+        if (!root_node) {
+            return changes;
+        }
+
+        std::unordered_map<uint32_t, bool> assigned{{*root_node, selected}};
+        std::deque<uint32_t> pending{*root_node};
+
+        // returns false when node was already forced the other way
+        const auto force = [&](const uint32_t node, const bool value) {
+            if (const auto it = assigned.find(node); it != assigned.end()) {
+                return it->second == value;
+            }
+            const auto current = state(nodes_[node]);
+            assigned.emplace(node, value);
+            if (current && *current != value) {
+                changes.emplace_back(nodes_[node], value);
+                pending.push_back(node);
+            }
+            return true;
+        };
+
+        while (!pending.empty()) {
+            const uint32_t node = pending.front();
+            pending.pop_front();
+
+            bool consistent = true;
+            if (assigned[node]) {
+                for (const uint32_t dependency : requires_[node]) {
+                    consistent = consistent && force(dependency, true);
+                }
+                for (const uint32_t other : conflicts_[node]) {
+                    consistent = consistent && force(other, false);
+                }
+                for (const uint32_t group : groups_of_[node]) {
+                    for (const uint32_t member : group_members_[group]) {
+                        consistent = consistent && (member == node || force(member, false));
+                    }
+                }
+            } else {
+                for (const uint32_t dependent : required_by_[node]) {
+                    consistent = consistent && force(dependent, false);
+                }
+            }
+            if (!consistent) {
+                return std::nullopt;
+            }
+        }
+        return changes;
+    }
+
+    ConstraintBuilder &ConstraintBuilder::require(std::string item, std::string dependency) {
+        requirements_.emplace_back(std::move(item), std::move(dependency));
+        return *this;
+    }
+
+    ConstraintBuilder &ConstraintBuilder::conflict(std::string a, std::string b) {
+        conflicts_.emplace_back(std::move(a), std::move(b));
+        return *this;
+    }
+
+    ConstraintBuilder &ConstraintBuilder::radio_group(std::vector<std::string> members) {
+        radio_groups_.push_back(std::move(members));
+        return *this;
+    }
+
+    std::optional<ConstraintGraph> ConstraintBuilder::build(const Resolver &resolve) {
+        problem_.clear();
+        ConstraintGraph graph;
+        std::unordered_map<std::string_view, uint32_t> node_of_name;
+
+        const auto node = [&](const std::string &name) -> std::optional<uint32_t> {
+            if (const auto it = node_of_name.find(name); it != node_of_name.end()) {
+                return it->second;
+            }
+            const ItemHandle item = resolve(name);
+            if (!item.valid()) {
+                problem_ = std::format("unknown item '{}'", name);
+                return std::nullopt;
+            }
+            const auto id = static_cast<uint32_t>(graph.nodes_.size());
+            graph.nodes_.push_back(item);
+            graph.node_of_slot_.emplace(item.slot, id);
+            node_of_name.emplace(name, id);
+            return id;
+        };
+
+        std::vector<std::pair<uint32_t, uint32_t>> requirements;
+        std::vector<std::pair<uint32_t, uint32_t>> conflicts;
+        std::vector<std::pair<uint32_t, uint32_t>> memberships;
+        for (const auto &[item, dependency] : requirements_) {
+            const auto from = node(item);
+            const auto to = node(dependency);
+            if (!from || !to) {
+                return std::nullopt;
+            }
+            requirements.emplace_back(*from, *to);
+        }
+        for (const auto &[a, b] : conflicts_) {
+            const auto first = node(a);
+            const auto second = node(b);
+            if (!first || !second) {
+                return std::nullopt;
+            }
+            conflicts.emplace_back(*first, *second);
+            conflicts.emplace_back(*second, *first);
+        }
+        for (uint32_t group = 0; group < radio_groups_.size(); ++group) {
+            for (const auto &name : radio_groups_[group]) {
+                const auto member = node(name);
+                if (!member) {
+                    return std::nullopt;
+                }
+                memberships.emplace_back(*member, group);
+            }
+        }
+
+        const size_t node_count = graph.nodes_.size();
+        std::vector<std::pair<uint32_t, uint32_t>> reversed;
+        reversed.reserve(requirements.size());
+        for (const auto &[from, to] : requirements) {
+            reversed.emplace_back(to, from);
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> members;
+        members.reserve(memberships.size());
+        for (const auto &[member, group] : memberships) {
+            members.emplace_back(group, member);
+        }
+
+        graph.requires_ = ConstraintGraph::Adjacency::pack(node_count, std::move(requirements));
+        graph.required_by_ = ConstraintGraph::Adjacency::pack(node_count, std::move(reversed));
+        graph.conflicts_ = ConstraintGraph::Adjacency::pack(node_count, std::move(conflicts));
+        graph.groups_of_ = ConstraintGraph::Adjacency::pack(node_count, std::move(memberships));
+        graph.group_members_ = ConstraintGraph::Adjacency::pack(radio_groups_.size(), std::move(members));
+
+        std::vector<std::string_view> name_of(node_count);
+        for (const auto &[name, id] : node_of_name) {
+            name_of[id] = name;
+        }
+
+        // iterative depth-first search over requirements; reaching a node still on the path closes a cycle
+        enum class Mark : uint8_t { unvisited, on_path, done };
+        std::vector<Mark> marks(node_count, Mark::unvisited);
+        std::vector<std::pair<uint32_t, size_t>> path; // node, next edge to follow
+        for (uint32_t start = 0; start < node_count; ++start) {
+            if (marks[start] != Mark::unvisited) {
+                continue;
+            }
+            marks[start] = Mark::on_path;
+            path.emplace_back(start, 0);
+            while (!path.empty()) {
+                auto &[current, next_edge] = path.back();
+                const auto edges = graph.requires_[current];
+                if (next_edge == edges.size()) {
+                    marks[current] = Mark::done;
+                    path.pop_back();
+                    continue;
+                }
+                const uint32_t target = edges[next_edge++];
+                if (marks[target] == Mark::unvisited) {
+                    marks[target] = Mark::on_path;
+                    path.emplace_back(target, 0);
+                } else if (marks[target] == Mark::on_path) {
+                    const auto first = std::ranges::find(path, target, &std::pair<uint32_t, size_t>::first);
+                    problem_ = "requirement cycle:";
+                    for (auto it = first; it != path.end(); ++it) {
+                        problem_ += std::format(" '{}' ->", name_of[it->first]);
+                    }
+                    problem_ += std::format(" '{}'", name_of[target]);
+                    return std::nullopt;
+                }
+            }
+        }
+
+        // a direct requirement between two items that exclude each other can never be selected
+        for (uint32_t from = 0; from < node_count; ++from) {
+            for (const uint32_t to : graph.requires_[from]) {
+                bool excluded = std::ranges::binary_search(graph.conflicts_[from], to);
+                for (const uint32_t group : graph.groups_of_[from]) {
+                    excluded = excluded || std::ranges::binary_search(graph.groups_of_[to], group);
+                }
+                if (excluded) {
+                    problem_ = std::format("'{}' requires '{}' but excludes it", name_of[from], name_of[to]);
+                    return std::nullopt;
+                }
+            }
+        }
+
+        return graph;
+    }
+
+} // namespace tui
@@ -0,0 +1,174 @@
+#include "file_watcher.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace tui {
+    namespace {
+        constexpr auto stop_check_interval = std::chrono::milliseconds(100);
+
+#ifdef __linux__
+        // writes in place, and saves that rename a finished file over the old one
+        constexpr uint32_t watch_mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE;
+#endif
+    } // namespace
+
+    FileWatcher::FileWatcher(Callback on_change, const std::chrono::milliseconds settle) :
+        on_change_(std::move(on_change)), settle_(settle) {
+#ifdef __linux__
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+        thread_ = std::jthread([this](const std::stop_token &stop) { run(stop); });
+    }
+
+    FileWatcher::~FileWatcher() {
+        // the thread reads inotify_fd_ until it is joined
+        thread_.request_stop();
+        thread_.join();
+#ifdef __linux__
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+        }
+#endif
+    }
+
+    bool FileWatcher::watch(const std::string &path) {
+        const std::filesystem::path file(path);
+        Watched watched{file.has_parent_path() ? file.parent_path() : std::filesystem::path("."),
+                        file.filename().string()};
+        if (watched.file_name.empty()) {
+            return false;
+        }
+
+#ifdef __linux__
+        if (inotify_fd_ < 0) {
+            return false;
+        }
+        // the same directory gets the same descriptor back
+        watched.descriptor = inotify_add_watch(inotify_fd_, watched.directory.c_str(), watch_mask);
+        if (watched.descriptor < 0) {
+            return false;
+        }
+#else
+        std::error_code error;
+        watched.written = std::filesystem::last_write_time(file, error);
+#endif
+
+        std::lock_guard lock(mutex_);
+        watched_.insert_or_assign(path, std::move(watched));
+        return true;
+    }
+
+    void FileWatcher::unwatch(const std::string &path) {
+        std::lock_guard lock(mutex_);
+        const auto it = watched_.find(path);
+        if (it == watched_.end()) {
+            return;
+        }
+        const int descriptor = it->second.descriptor;
+        watched_.erase(it);
+        pending_.erase(path);
+
+#ifdef __linux__
+        const bool shared = std::ranges::any_of(
+            watched_, [descriptor](const auto &entry) { return entry.second.descriptor == descriptor; });
+        if (!shared) {
+            inotify_rm_watch(inotify_fd_, descriptor);
+        }
+#else
+        (void)descriptor;
+#endif
+    }
+
+    void FileWatcher::run(const std::stop_token &stop) {
+        while (!stop.stop_requested()) {
+            auto wait = stop_check_interval;
+            {
+                std::lock_guard lock(mutex_);
+                const auto now = std::chrono::steady_clock::now();
+                for (const auto &deadline : pending_ | std::views::values) {
+                    wait = std::min(wait, std::chrono::ceil<std::chrono::milliseconds>(
+                                              std::max(deadline - now, std::chrono::steady_clock::duration::zero())));
+                }
+            }
+
+#ifdef __linux__
+            pollfd pfd{inotify_fd_, POLLIN, 0};
+            if (inotify_fd_ < 0 || poll(&pfd, 1, static_cast<int>(wait.count())) < 0) {
+                std::this_thread::sleep_for(wait);
+            }
+#else
+            std::this_thread::sleep_for(wait);
+#endif
+
+            const auto now = std::chrono::steady_clock::now();
+            collect_changes(now);
+
+            // report outside the lock, so the callback may watch and unwatch
+            std::vector<std::string> due;
+            {
+                std::lock_guard lock(mutex_);
+                for (auto it = pending_.begin(); it != pending_.end();) {
+                    if (it->second <= now) {
+                        due.push_back(it->first);
+                        it = pending_.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            for (const auto &path : due) {
+                on_change_(path);
+            }
+        }
+    }
+
+    void FileWatcher::collect_changes(const std::chrono::steady_clock::time_point now) {
+#ifdef __linux__
+        if (inotify_fd_ < 0) {
+            return;
+        }
+        alignas(inotify_event) char buffer[16 * 1024];
+        while (true) {
+            const ssize_t length = read(inotify_fd_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                return;
+            }
+
+            std::lock_guard lock(mutex_);
+            for (ssize_t offset = 0; offset < length;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                if (event->len == 0) {
+                    continue;
+                }
+                const std::string_view name(event->name);
+                for (const auto &[path, watched] : watched_) {
+                    if (watched.descriptor == event->wd && watched.file_name == name) {
+                        // every further event pushes the report back
+                        pending_[path] = now + settle_;
+                    }
+                }
+            }
+        }
+#else
+        std::lock_guard lock(mutex_);
+        for (auto &[path, watched] : watched_) {
+            std::error_code error;
+            const auto written = std::filesystem::last_write_time(path, error);
+            if (!error && written != watched.written) {
+                watched.written = written;
+                pending_[path] = now + settle_;
+            }
+        }
+#endif
+    }
+
+} // namespace tui
@@ -0,0 +1,98 @@
+#include "item_feed.hpp"
+
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace tui {
+    namespace {
+        constexpr size_t chunk_size = 64 * 1024;
+
+        /**
+         * @brief Read one chunk; 0 on end of file, -1 on error, -2 if stop was requested
+         */
+        long read_chunk(const int fd, char *buffer, const std::stop_token &stop) {
+#ifdef _WIN32
+            // no way to wait on an anonymous pipe here; stop is only seen between chunks
+            if (stop.stop_requested()) {
+                return -2;
+            }
+            return _read(fd, buffer, static_cast<unsigned>(chunk_size));
+#else
+            pollfd pfd{fd, POLLIN, 0};
+            while (!stop.stop_requested()) {
+                if (const int ready = poll(&pfd, 1, 100); ready < 0) {
+                    return -1;
+                } else if (ready > 0) {
+                    return read(fd, buffer, chunk_size);
+                }
+            }
+            return -2;
+#endif
+        }
+
+        SelectableItem parse_line(std::string_view line) {
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (const size_t tab = line.find('\t'); tab != std::string_view::npos) {
+                return {std::string(line.substr(0, tab)), std::string(line.substr(tab + 1))};
+            }
+            return SelectableItem(std::string(line));
+        }
+    } // namespace
+
+    std::jthread stream_lines(const int fd, std::shared_ptr<ItemFeed> feed, const SectionHandle section) {
+        return std::jthread([fd, feed = std::move(feed), section](const std::stop_token &stop) {
+            std::string buffer(chunk_size, '\0');
+            std::string partial;
+
+            while (true) {
+                const long count = read_chunk(fd, buffer.data(), stop);
+                if (count <= 0) {
+                    break;
+                }
+
+                std::vector<SelectableItem> items;
+                std::string_view chunk(buffer.data(), static_cast<size_t>(count));
+                for (size_t newline; (newline = chunk.find('\n')) != std::string_view::npos;) {
+                    if (partial.empty()) {
+                        items.push_back(parse_line(chunk.substr(0, newline)));
+                    } else {
+                        partial.append(chunk.substr(0, newline));
+                        items.push_back(parse_line(partial));
+                        partial.clear();
+                    }
+                    chunk.remove_prefix(newline + 1);
+                }
+                partial.append(chunk);
+
+                feed->push(section, std::move(items));
+            }
+
+            if (!partial.empty() && !stop.stop_requested()) {
+                feed->push(section, {parse_line(partial)});
+            }
+            feed->close(section);
+        });
+    }
+
+    std::jthread run_provider(SectionProvider provider, std::shared_ptr<ItemFeed> feed, const SectionHandle section) {
+        return std::jthread(
+            [provider = std::move(provider), feed = std::move(feed), section](const std::stop_token &stop) {
+                ItemSink sink(feed, section, stop);
+                try {
+                    provider(sink);
+                } catch (...) {
+                    // a failing probe just ends up with fewer (or no) items
+                }
+                feed->close(section);
+            });
+    }
+} // namespace tui
@@ -0,0 +1,363 @@
+#include "item_parsers.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace tui {
+    namespace {
+        std::string_view trim(std::string_view text) {
+            const auto first = text.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) {
+                return {};
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+        }
+
+        bool is_true(std::string_view value) {
+            return value == "1" || value == "true" || value == "yes" || value == "on" || value == "True" ||
+                value == "TRUE" || value == "Yes" || value == "On";
+        }
+
+        // calls fn(line) for every line without its terminator
+        template <typename Fn>
+        void for_each_line(std::string_view contents, Fn &&fn) {
+            while (!contents.empty()) {
+                const size_t end = contents.find('\n');
+                fn(contents.substr(0, end));
+                contents.remove_prefix(end == std::string_view::npos ? contents.size() : end + 1);
+            }
+        }
+
+        std::vector<SelectableItem> parse_lines(const std::string_view contents) {
+            std::vector<SelectableItem> items;
+            for_each_line(contents, [&](std::string_view line) {
+                if (line.ends_with('\r')) {
+                    line.remove_suffix(1);
+                }
+                if (line.empty()) {
+                    return;
+                }
+                if (const size_t tab = line.find('\t'); tab != std::string_view::npos) {
+                    items.emplace_back(std::string(line.substr(0, tab)), std::string(line.substr(tab + 1)));
+                } else {
+                    items.emplace_back(std::string(line));
+                }
+            });
+            return items;
+        }
+
+        std::optional<std::vector<SelectableItem>> parse_ini(const std::string_view contents,
+                                                             const std::string_view section_name) {
+            std::vector<SelectableItem> items;
+            bool found = false;
+            bool inside = false;
+            for_each_line(contents, [&](const std::string_view raw) {
+                const std::string_view line = trim(raw);
+                if (line.empty() || line.front() == ';' || line.front() == '#') {
+                    return;
+                }
+                if (line.front() == '[' && line.back() == ']') {
+                    inside = trim(line.substr(1, line.size() - 2)) == section_name;
+                    found = found || inside;
+                    return;
+                }
+                if (!inside) {
+                    return;
+                }
+                const size_t equals = line.find('=');
+                auto &item = items.emplace_back(std::string(trim(line.substr(0, equals))));
+                item.selected = equals != std::string_view::npos && is_true(trim(line.substr(equals + 1)));
+            });
+            if (!found) {
+                return std::nullopt;
+            }
+            return items;
+        }
+
+        /**
+         * @brief Just enough JSON for item lists; any syntax error fails the whole parse
+         */
+        class JsonReader {
+        public:
+            explicit JsonReader(const std::string_view text) : text_(text) {}
+
+            std::optional<std::vector<SelectableItem>> items() {
+                std::vector<SelectableItem> items;
+                if (!consume('[')) {
+                    return std::nullopt;
+                }
+                if (!consume(']')) {
+                    do {
+                        auto item = this->item();
+                        if (!item) {
+                            return std::nullopt;
+                        }
+                        items.push_back(std::move(*item));
+                    } while (consume(','));
+                    if (!consume(']')) {
+                        return std::nullopt;
+                    }
+                }
+                skip_space();
+                if (at_ != text_.size()) {
+                    return std::nullopt;
+                }
+                return items;
+            }
+
+        private:
+            std::optional<SelectableItem> item() {
+                skip_space();
+                if (peek() == '"') {
+                    auto name = string();
+                    return name ? std::optional(SelectableItem(std::move(*name))) : std::nullopt;
+                }
+                if (!consume('{')) {
+                    return std::nullopt;
+                }
+
+                std::optional<std::string> name;
+                std::string description;
+                int id = 0;
+                bool selected = false;
+                if (!consume('}')) {
+                    do {
+                        skip_space();
+                        const auto key = string();
+                        if (!key || !consume(':')) {
+                            return std::nullopt;
+                        }
+                        skip_space();
+                        bool ok = true;
+                        if (*key == "name") {
+                            name = string();
+                            ok = name.has_value();
+                        } else if (*key == "description") {
+                            auto text = string();
+                            ok = text.has_value();
+                            description = text.value_or("");
+                        } else if (*key == "id") {
+                            ok = integer(id);
+                        } else if (*key == "selected") {
+                            ok = boolean(selected);
+                        } else {
+                            ok = skip_value();
+                        }
+                        if (!ok) {
+                            return std::nullopt;
+                        }
+                    } while (consume(','));
+                    if (!consume('}')) {
+                        return std::nullopt;
+                    }
+                }
+                if (!name) {
+                    return std::nullopt;
+                }
+                SelectableItem item(std::move(*name), std::move(description), id);
+                item.selected = selected;
+                return item;
+            }
+
+            std::optional<std::string> string() {
+                if (peek() != '"') {
+                    return std::nullopt;
+                }
+                ++at_;
+                std::string out;
+                while (at_ < text_.size()) {
+                    const char c = text_[at_++];
+                    if (c == '"') {
+                        return out;
+                    }
+                    if (c != '\\') {
+                        out.push_back(c);
+                        continue;
+                    }
+                    if (at_ >= text_.size()) {
+                        return std::nullopt;
+                    }
+                    switch (const char escape = text_[at_++]) {
+                    case 'n':
+                        out.push_back('\n');
+                        break;
+                    case 't':
+                        out.push_back('\t');
+                        break;
+                    case 'r':
+                        out.push_back('\r');
+                        break;
+                    case 'b':
+                        out.push_back('\b');
+                        break;
+                    case 'f':
+                        out.push_back('\f');
+                        break;
+                    case 'u':
+                        if (!unicode_escape(out)) {
+                            return std::nullopt;
+                        }
+                        break;
+                    default:
+                        out.push_back(escape); // '"', '\\' and '/'
+                    }
+                }
+                return std::nullopt;
+            }
+
+            bool unicode_escape(std::string &out) {
+                uint32_t code = 0;
+                if (!hex4(code)) {
+                    return false;
+                }
+                // a high surrogate must be followed by \uDC00-\uDFFF
+                if (code >= 0xD800 && code < 0xDC00) {
+                    uint32_t low = 0;
+                    if (text_.substr(at_, 2) != "\\u") {
+                        return false;
+                    }
+                    at_ += 2;
+                    if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                        return false;
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                if (code < 0x80) {
+                    out.push_back(static_cast<char>(code));
+                } else if (code < 0x800) {
+                    out.push_back(static_cast<char>(0xC0 | code >> 6));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                } else if (code < 0x10000) {
+                    out.push_back(static_cast<char>(0xE0 | code >> 12));
+                    out.push_back(static_cast<char>(0x80 | (code >> 6 & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                } else {
+                    out.push_back(static_cast<char>(0xF0 | code >> 18));
+                    out.push_back(static_cast<char>(0x80 | (code >> 12 & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | (code >> 6 & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                return true;
+            }
+
+            bool hex4(uint32_t &code) {
+                if (at_ + 4 > text_.size()) {
+                    return false;
+                }
+                const auto [end, error] = std::from_chars(text_.data() + at_, text_.data() + at_ + 4, code, 16);
+                if (error != std::errc{} || end != text_.data() + at_ + 4) {
+                    return false;
+                }
+                at_ += 4;
+                return true;
+            }
+
+            bool integer(int &value) {
+                const auto [end, error] = std::from_chars(text_.data() + at_, text_.data() + text_.size(), value);
+                if (error != std::errc{}) {
+                    return false;
+                }
+                at_ = static_cast<size_t>(end - text_.data());
+                return true;
+            }
+
+            bool boolean(bool &value) {
+                if (text_.substr(at_).starts_with("true")) {
+                    value = true;
+                    at_ += 4;
+                    return true;
+                }
+                if (text_.substr(at_).starts_with("false")) {
+                    value = false;
+                    at_ += 5;
+                    return true;
+                }
+                return false;
+            }
+
+            // skips any value, containers included
+            bool skip_value() {
+                skip_space();
+                const char c = peek();
+                if (c == '"') {
+                    return string().has_value();
+                }
+                if (c == '[' || c == '{') {
+                    const char close = c == '[' ? ']' : '}';
+                    ++at_;
+                    if (consume(close)) {
+                        return true;
+                    }
+                    do {
+                        if (c == '{') {
+                            skip_space();
+                            if (!string() || !consume(':')) {
+                                return false;
+                            }
+                        }
+                        if (!skip_value()) {
+                            return false;
+                        }
+                    } while (consume(','));
+                    return consume(close);
+                }
+                // numbers, true, false, null
+                const size_t start = at_;
+                constexpr std::string_view literal_chars = "+-.0123456789Eaeflnrstu";
+                while (at_ < text_.size() && literal_chars.find(text_[at_]) != std::string_view::npos) {
+                    ++at_;
+                }
+                return at_ > start;
+            }
+
+            void skip_space() {
+                while (at_ < text_.size() && std::string_view(" \t\r\n").find(text_[at_]) != std::string_view::npos) {
+                    ++at_;
+                }
+            }
+
+            bool consume(const char c) {
+                skip_space();
+                if (peek() != c) {
+                    return false;
+                }
+                ++at_;
+                return true;
+            }
+
+            [[nodiscard]] char peek() const { return at_ < text_.size() ? text_[at_] : '\0'; }
+
+            std::string_view text_;
+            size_t at_ = 0;
+        };
+    } // namespace
+
+    std::optional<std::vector<SelectableItem>> parse_items(const std::string_view contents, const ItemFileFormat format,
+                                                           const std::string_view section_name) {
+        switch (format) {
+        case ItemFileFormat::lines:
+            return parse_lines(contents);
+        case ItemFileFormat::ini:
+            return parse_ini(contents, section_name);
+        case ItemFileFormat::json:
+            return JsonReader(contents).items();
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::vector<SelectableItem>> load_items(const std::string &path, const ItemFileFormat format,
+                                                          const std::string_view section_name) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        const std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        if (file.bad()) {
+            return std::nullopt;
+        }
+        return parse_items(contents, format, section_name);
+    }
+
+} // namespace tui
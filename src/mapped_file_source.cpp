@@ -0,0 +1,125 @@
+#include "mapped_file_source.hpp"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace tui {
+    std::shared_ptr<MappedFileSource> MappedFileSource::open(const std::string &path) {
+        std::shared_ptr<MappedFileSource> source(new MappedFileSource());
+        source->path_ = path;
+
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return nullptr;
+        }
+        source->buffer_.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(source->buffer_.data(), static_cast<std::streamsize>(source->buffer_.size()))) {
+            return nullptr;
+        }
+        source->data_ = source->buffer_.data();
+        source->length_ = source->buffer_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return nullptr;
+        }
+
+        if (st.st_size > 0) {
+            void *mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                return nullptr;
+            }
+            // the whole file is scanned once right away
+            madvise(mapping, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+            source->data_ = static_cast<const char *>(mapping);
+            source->length_ = static_cast<size_t>(st.st_size);
+        }
+        // the mapping keeps the file alive
+        close(fd);
+#endif
+
+        source->index_lines();
+
+#ifndef _WIN32
+        if (source->data_) {
+            // later access follows the cursor, not the file
+            madvise(const_cast<char *>(source->data_), source->length_, MADV_RANDOM);
+        }
+#endif
+        return source;
+    }
+
+    MappedFileSource::~MappedFileSource() {
+#ifndef _WIN32
+        if (data_) {
+            munmap(const_cast<char *>(data_), length_);
+        }
+#endif
+    }
+
+    void MappedFileSource::index_lines() {
+        if (length_ == 0) {
+            return;
+        }
+
+        // memchr is vectorized by every libc we care about and beats a hand-rolled loop
+        line_starts_.push_back(0);
+        const char *const end = data_ + length_;
+        for (const char *cursor = data_; cursor < end;) {
+            const auto *newline = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+            if (!newline) {
+                break;
+            }
+            cursor = newline + 1;
+            if (cursor < end) {
+                line_starts_.push_back(static_cast<size_t>(cursor - data_));
+            }
+        }
+        line_starts_.shrink_to_fit();
+    }
+
+    std::string_view MappedFileSource::line(const size_t index) const {
+        if (index >= line_starts_.size()) {
+            return {};
+        }
+
+        const size_t start = line_starts_[index];
+        size_t end = (index + 1 < line_starts_.size()) ? line_starts_[index + 1] : length_;
+        if (end > start && data_[end - 1] == '\n') {
+            --end;
+        }
+        if (end > start && data_[end - 1] == '\r') {
+            --end;
+        }
+        return {data_ + start, end - start};
+    }
+
+    std::string_view MappedFileSource::name(const size_t index) const {
+        const std::string_view text = line(index);
+        return text.substr(0, text.find('\t'));
+    }
+
+    std::string_view MappedFileSource::description(const size_t index) const {
+        const std::string_view text = line(index);
+        const size_t tab = text.find('\t');
+        return (tab != std::string_view::npos) ? text.substr(tab + 1) : std::string_view{};
+    }
+} // namespace tui
@@ -0,0 +1,184 @@
+#include "prefetching_source.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tui {
+    PrefetchingSource::PrefetchingSource(const size_t size, PageFetcher fetcher, Options options) :
+        size_(size), fetcher_(std::move(fetcher)), options_(options),
+        cache_(std::max<size_t>(options.cache_pages, 1)) {
+        options_.page_size = std::max<size_t>(options_.page_size, 1);
+        options_.max_read_ahead = std::max(options_.max_read_ahead, options_.read_ahead);
+    }
+
+    std::string_view PrefetchingSource::name(const size_t index) const {
+        const Row *entry = row(index);
+        return entry ? std::string_view(entry->name) : std::string_view();
+    }
+
+    std::string_view PrefetchingSource::description(const size_t index) const {
+        const Row *entry = row(index);
+        return entry ? std::string_view(entry->description) : std::string_view();
+    }
+
+    bool PrefetchingSource::is_ready(const size_t index) const {
+        std::lock_guard lock(mutex_);
+        return index >= size_ || cache_.contains(index / options_.page_size);
+    }
+
+    const PrefetchingSource::Row *PrefetchingSource::row(const size_t index) const {
+        if (index >= size_) {
+            return nullptr;
+        }
+
+        const size_t page = index / options_.page_size;
+        std::unique_lock lock(mutex_);
+        auto *rows = cache_.find(page);
+        while (!rows) {
+            // somebody needs this row right now: move the fetch to the front and wait for it
+            lock.unlock();
+            request(page, true);
+            lock.lock();
+            arrived_.wait(lock, [&] { return cache_.contains(page) || !in_flight_.contains(page); });
+            rows = cache_.contains(page) ? cache_.find(page) : nullptr;
+        }
+
+        // keep the page alive for the views handed out, even if it's evicted meanwhile
+        pinned_[next_pin_] = *rows;
+        next_pin_ = (next_pin_ + 1) % std::size(pinned_);
+
+        const size_t offset = index % options_.page_size;
+        return offset < (*rows)->size() ? &(**rows)[offset] : nullptr;
+    }
+
+    void PrefetchingSource::on_view(const size_t first, const size_t last) const {
+        if (first >= last || first >= size_) {
+            return;
+        }
+
+        const size_t first_page = first / options_.page_size;
+        const size_t last_page = (std::min(last, size_) - 1) / options_.page_size;
+        const auto now = std::chrono::steady_clock::now();
+
+        if (last_view_page_ && *last_view_page_ != first_page) {
+            const double seconds = std::chrono::duration<double>(now - last_view_time_).count();
+            const double distance = std::abs(static_cast<double>(first_page) - static_cast<double>(*last_view_page_));
+            const double speed = distance / std::max(seconds, 0.001);
+            pages_per_second_ = 0.5 * pages_per_second_ + 0.5 * speed;
+
+            const int direction = first_page > *last_view_page_ ? 1 : -1;
+            if (direction != direction_) {
+                direction_ = direction;
+                // prefetches queued for the old direction are no longer worth the wait
+                std::lock_guard lock(mutex_);
+                ++generation_;
+            }
+            last_view_time_ = now;
+        } else if (!last_view_page_) {
+            last_view_time_ = now;
+        } else if (now - last_view_time_ > std::chrono::seconds(1)) {
+            pages_per_second_ = 0.0;
+        }
+        last_view_page_ = first_page;
+
+        for (size_t page = first_page; page <= last_page; ++page) {
+            request(page, true);
+        }
+
+        // read further ahead the faster the user pages, but never so far that it evicts the view
+        const size_t page_count = (size_ + options_.page_size - 1) / options_.page_size;
+        size_t ahead = options_.read_ahead + static_cast<size_t>(pages_per_second_);
+        ahead = std::min(ahead, options_.max_read_ahead);
+        {
+            std::lock_guard lock(mutex_);
+            ahead = std::min(ahead, cache_.capacity() / 2);
+        }
+        for (size_t step = 1; step <= ahead; ++step) {
+            if (direction_ > 0) {
+                if (last_page + step >= page_count) {
+                    break;
+                }
+                request(last_page + step, false);
+            } else {
+                if (first_page < step) {
+                    break;
+                }
+                request(first_page - step, false);
+            }
+        }
+    }
+
+    void PrefetchingSource::request(const size_t page, const bool urgent) const {
+        std::lock_guard lock(mutex_);
+        if (cache_.contains(page)) {
+            return;
+        }
+
+        if (const auto it = in_flight_.find(page); it != in_flight_.end()) {
+            if (!urgent || it->second) {
+                return;
+            }
+            // queued as a prefetch, but now it's on screen: post again ahead of the queue
+            it->second = true;
+        } else {
+            in_flight_.emplace(page, urgent);
+        }
+
+        const uint64_t generation = generation_;
+        auto task = [this, page, generation] { run_fetch(page, generation); };
+        if (urgent) {
+            worker_.post_urgent(std::move(task));
+        } else {
+            worker_.post(std::move(task));
+        }
+    }
+
+    void PrefetchingSource::run_fetch(const size_t page, const uint64_t generation) const {
+        {
+            std::lock_guard lock(mutex_);
+            const auto it = in_flight_.find(page);
+            if (it == in_flight_.end() || cache_.contains(page)) {
+                return; // already served by a duplicate task
+            }
+            if (!it->second && generation != generation_) {
+                in_flight_.erase(it);
+                return;
+            }
+        }
+
+        const size_t first = page * options_.page_size;
+        const size_t count = std::min(options_.page_size, size_ - first);
+        std::shared_ptr<const Page> rows;
+        try {
+            rows = std::make_shared<const Page>(fetcher_(first, count));
+        } catch (...) {
+            // an unreachable backend shows empty rows instead of taking the UI down
+            rows = std::make_shared<const Page>();
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            const auto it = in_flight_.find(page);
+            if (it != in_flight_.end() && !it->second) {
+                ++prefetched_pages_;
+            }
+            in_flight_.erase(page);
+            cache_.put(page, std::move(rows));
+            ++fetched_pages_;
+        }
+        revision_.fetch_add(1, std::memory_order_release);
+        arrived_.notify_all();
+    }
+
+    void PrefetchingSource::set_cache_pages(const size_t pages) {
+        std::lock_guard lock(mutex_);
+        cache_.set_capacity(std::max<size_t>(pages, 1));
+    }
+
+    PrefetchingSource::Stats PrefetchingSource::stats() const {
+        std::lock_guard lock(mutex_);
+        const auto &cache_stats = cache_.stats();
+        return {cache_stats.hits, cache_stats.misses, cache_stats.evictions, fetched_pages_, prefetched_pages_,
+                cache_.size(), cache_.capacity()};
+    }
+} // namespace tui
@@ -0,0 +1,113 @@
+#include "selection_export.hpp"
+
+#include <cerrno>
+#include <iterator>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace tui {
+    SelectionExporter::SelectionExporter(const int fd, const ExportFormat format, const size_t buffer_size) :
+        fd_(fd), format_(format), capacity_(buffer_size > 0 ? buffer_size : 1) {
+        buffer_.reserve(capacity_);
+    }
+
+    SelectionExporter::~SelectionExporter() { flush_buffer(); }
+
+    void SelectionExporter::add(const std::string_view section, const std::string_view item) {
+        if (failed_) {
+            return;
+        }
+
+        switch (format_) {
+        case ExportFormat::lines:
+            buffer_.insert(buffer_.end(), item.begin(), item.end());
+            buffer_.push_back('\n');
+            break;
+        case ExportFormat::json_lines: {
+            constexpr std::string_view section_key = "{\"section\":";
+            constexpr std::string_view item_key = ",\"item\":";
+            buffer_.insert(buffer_.end(), section_key.begin(), section_key.end());
+            append_json_string(section);
+            buffer_.insert(buffer_.end(), item_key.begin(), item_key.end());
+            append_json_string(item);
+            buffer_.push_back('}');
+            buffer_.push_back('\n');
+            break;
+        }
+        case ExportFormat::nul:
+            buffer_.insert(buffer_.end(), item.begin(), item.end());
+            buffer_.push_back('\0');
+            break;
+        }
+
+        ++exported_;
+        if (buffer_.size() >= capacity_) {
+            flush_buffer();
+        }
+    }
+
+    bool SelectionExporter::finish() {
+        flush_buffer();
+        return !failed_;
+    }
+
+    void SelectionExporter::append_json_string(const std::string_view text) {
+        constexpr char hex[] = "0123456789abcdef";
+        buffer_.push_back('"');
+        for (const char c : text) {
+            const auto byte = static_cast<unsigned char>(c);
+            switch (c) {
+            case '"':
+            case '\\':
+                buffer_.push_back('\\');
+                buffer_.push_back(c);
+                break;
+            case '\n':
+                buffer_.push_back('\\');
+                buffer_.push_back('n');
+                break;
+            case '\t':
+                buffer_.push_back('\\');
+                buffer_.push_back('t');
+                break;
+            case '\r':
+                buffer_.push_back('\\');
+                buffer_.push_back('r');
+                break;
+            default:
+                if (byte < 0x20) {
+                    const char escape[] = {'\\', 'u', '0', '0', hex[byte >> 4], hex[byte & 0xF]};
+                    buffer_.insert(buffer_.end(), std::begin(escape), std::end(escape));
+                } else {
+                    // UTF-8 passes through as is
+                    buffer_.push_back(c);
+                }
+            }
+        }
+        buffer_.push_back('"');
+    }
+
+    void SelectionExporter::flush_buffer() {
+        for (size_t done = 0; !failed_ && done < buffer_.size();) {
+#ifdef _WIN32
+            const int n = _write(fd_, buffer_.data() + done, static_cast<unsigned>(buffer_.size() - done));
+#else
+            const ssize_t n = ::write(fd_, buffer_.data() + done, buffer_.size() - done);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (n <= 0) {
+                failed_ = true;
+            } else {
+                done += static_cast<size_t>(n);
+            }
+        }
+        buffer_.clear();
+    }
+
+} // namespace tui
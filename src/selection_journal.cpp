@@ -0,0 +1,151 @@
+#include "selection_journal.hpp"
+
+#include <algorithm>
+
+namespace tui {
+
+    IndexSet::IndexSet(const std::span<const uint32_t> sorted) : count_(static_cast<uint32_t>(sorted.size())) {
+        if (sorted.empty()) {
+            return;
+        }
+
+        size_t runs = 1;
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            runs += sorted[i] != sorted[i - 1] + 1 ? 1 : 0;
+        }
+        const size_t span = static_cast<size_t>(sorted.back() - sorted.front()) + 1;
+
+        const size_t list_words = sorted.size();
+        const size_t run_words = runs * 2;
+        const size_t bitmap_words = (span + 31) / 32;
+
+        if (list_words <= run_words && list_words <= bitmap_words) {
+            encoding_ = Encoding::list;
+            words_.assign(sorted.begin(), sorted.end());
+        } else if (run_words <= bitmap_words) {
+            encoding_ = Encoding::runs;
+            words_.reserve(run_words);
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                if (i > 0 && sorted[i] == sorted[i - 1] + 1) {
+                    ++words_.back();
+                } else {
+                    words_.push_back(sorted[i]);
+                    words_.push_back(1);
+                }
+            }
+        } else {
+            encoding_ = Encoding::bitmap;
+            first_ = sorted.front();
+            words_.assign(bitmap_words, 0);
+            for (const uint32_t index : sorted) {
+                const uint32_t offset = index - first_;
+                words_[offset / 32] |= uint32_t{1} << (offset % 32);
+            }
+        }
+    }
+
+    void SelectionJournal::record(const SectionHandle section, const uint64_t index_revision,
+                                  const std::span<const ItemChange> changes) {
+        if (changes.empty() || limit_ == 0) {
+            return;
+        }
+
+        std::vector<uint32_t> selected;
+        std::vector<uint32_t> deselected;
+        if (std::ranges::is_sorted(changes, std::ranges::less{}, &ItemChange::item_index) &&
+            std::ranges::adjacent_find(changes, {}, &ItemChange::item_index) == changes.end()) {
+            // bulk operations walk the section in index order; no need to copy and sort
+            for (const auto &[item_index, is_selected] : changes) {
+                (is_selected ? selected : deselected).push_back(static_cast<uint32_t>(item_index));
+            }
+        } else {
+            std::vector<ItemChange> ordered(changes.begin(), changes.end());
+            std::ranges::stable_sort(ordered, {}, &ItemChange::item_index);
+            for (auto it = ordered.begin(); it != ordered.end();) {
+                const auto end = std::ranges::find_if(
+                    it, ordered.end(), [&](const ItemChange &change) { return change.item_index != it->item_index; });
+                // every change is a flip, so an even count leaves the item as it was
+                if ((end - it) % 2 == 1) {
+                    const auto &last = *(end - 1);
+                    (last.selected ? selected : deselected).push_back(static_cast<uint32_t>(last.item_index));
+                }
+                it = end;
+            }
+        }
+
+        if (selected.empty() && deselected.empty()) {
+            return;
+        }
+        redo_.clear();
+        push_undo(Entry{section, index_revision, IndexSet(selected), IndexSet(deselected)});
+    }
+
+    std::optional<SelectionJournal::Entry> SelectionJournal::pop_undo() {
+        if (undo_.empty()) {
+            return std::nullopt;
+        }
+        Entry entry = std::move(undo_.back());
+        undo_.pop_back();
+        return entry;
+    }
+
+    std::optional<SelectionJournal::Entry> SelectionJournal::pop_redo() {
+        if (redo_.empty()) {
+            return std::nullopt;
+        }
+        Entry entry = std::move(redo_.back());
+        redo_.pop_back();
+        return entry;
+    }
+
+    void SelectionJournal::push_undo(Entry entry) {
+        undo_.push_back(std::move(entry));
+        while (undo_.size() > limit_) {
+            undo_.pop_front();
+        }
+    }
+
+    void SelectionJournal::push_redo(Entry entry) {
+        redo_.push_back(std::move(entry));
+        while (redo_.size() > limit_) {
+            redo_.pop_front();
+        }
+    }
+
+    void SelectionJournal::rebase(const SectionHandle section, const uint64_t from_revision,
+                                  const uint64_t to_revision) {
+        for (auto *history : {&undo_, &redo_}) {
+            for (auto &entry : *history) {
+                if (entry.section == section && entry.index_revision == from_revision) {
+                    entry.index_revision = to_revision;
+                }
+            }
+        }
+    }
+
+    void SelectionJournal::set_limit(const size_t limit) {
+        limit_ = limit;
+        while (undo_.size() > limit_) {
+            undo_.pop_front();
+        }
+        while (redo_.size() > limit_) {
+            redo_.pop_front();
+        }
+    }
+
+    void SelectionJournal::clear() {
+        undo_.clear();
+        redo_.clear();
+    }
+
+    size_t SelectionJournal::memory_usage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto *history : {&undo_, &redo_}) {
+            for (const auto &entry : *history) {
+                bytes += entry.memory_usage();
+            }
+        }
+        return bytes;
+    }
+
+} // namespace tui
@@ -0,0 +1,332 @@
+#include "selection_snapshot.hpp"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tui {
+    namespace {
+        constexpr char magic[8] = {'R', 'T', 'U', 'I', 'S', 'N', 'A', 'P'};
+        constexpr size_t header_size = 24; ///< magic, u32 version, u32 section count, u64 file size
+        constexpr size_t record_size = 32; ///< u64 name hash, u64 hashes/bits offsets, u32 count, u32 selected
+
+        uint64_t load_u64(const unsigned char *data) {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+
+        uint32_t load_u32(const unsigned char *data) {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            return value;
+        }
+
+        template <typename T>
+        void store(std::vector<unsigned char> &out, T value) {
+            if constexpr (std::endian::native == std::endian::big) {
+                value = std::byteswap(value);
+            }
+            const size_t at = out.size();
+            out.resize(at + sizeof(value));
+            std::memcpy(out.data() + at, &value, sizeof(value));
+        }
+
+        uint64_t mix(uint64_t h) {
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+    } // namespace
+
+    uint64_t snapshot_hash(const std::string_view name) {
+        constexpr uint64_t k0 = 0x9E3779B97F4A7C15ULL;
+        constexpr uint64_t k1 = 0xC2B2AE3D27D4EB4FULL;
+
+        const auto *bytes = reinterpret_cast<const unsigned char *>(name.data());
+        size_t remaining = name.size();
+        uint64_t h = k0 ^ (name.size() * k1);
+        for (; remaining >= 8; bytes += 8, remaining -= 8) {
+            h = std::rotl((h ^ load_u64(bytes)) * k1, 31) * k0;
+        }
+        if (remaining > 0) {
+            uint64_t tail;
+            if (name.size() >= 8) {
+                // the last eight bytes overlap the previous word, which is cheaper than a byte loop
+                tail = load_u64(bytes + remaining - 8);
+            } else {
+                unsigned char padded[8] = {};
+                std::memcpy(padded, bytes, remaining);
+                tail = load_u64(padded);
+            }
+            h = std::rotl((h ^ tail) * k1, 31) * k0;
+        }
+        return mix(h);
+    }
+
+    void SnapshotWriter::begin_section(const std::string_view name, const size_t item_count) {
+        begin_hashed_section(snapshot_hash(name), item_count);
+    }
+
+    void SnapshotWriter::add_item(const std::string_view name, const bool selected) {
+        add_hashed_item(snapshot_hash(name), selected);
+    }
+
+    void SnapshotWriter::begin_hashed_section(const uint64_t name_hash, const size_t item_count) {
+        auto &section = sections_.emplace_back();
+        section.name_hash = name_hash;
+        section.hashes.reserve(item_count);
+        section.bits.reserve((item_count + 63) / 64);
+    }
+
+    void SnapshotWriter::add_hashed_item(const uint64_t name_hash, const bool selected) {
+        if (sections_.empty()) {
+            begin_section({});
+        }
+        auto &section = sections_.back();
+        const size_t position = section.hashes.size();
+        section.hashes.push_back(name_hash);
+        if (position % 64 == 0) {
+            section.bits.push_back(0);
+        }
+        if (selected) {
+            section.bits.back() |= uint64_t{1} << (position % 64);
+            ++section.selected;
+        }
+    }
+
+    bool SnapshotWriter::write(const std::string &path) const {
+        size_t offset = header_size + record_size * sections_.size();
+        std::vector<unsigned char> out;
+        out.reserve(offset);
+
+        out.insert(out.end(), std::begin(magic), std::end(magic));
+        store(out, SnapshotReader::version);
+        store(out, static_cast<uint32_t>(sections_.size()));
+        const size_t file_size_at = out.size();
+        store(out, uint64_t{0}); // patched below
+
+        for (const auto &section : sections_) {
+            const size_t hashes_offset = offset;
+            const size_t bits_offset = hashes_offset + section.hashes.size() * sizeof(uint64_t);
+            offset = bits_offset + section.bits.size() * sizeof(uint64_t);
+
+            store(out, section.name_hash);
+            store(out, static_cast<uint64_t>(hashes_offset));
+            store(out, static_cast<uint64_t>(bits_offset));
+            store(out, static_cast<uint32_t>(section.hashes.size()));
+            store(out, section.selected);
+        }
+
+        out.reserve(offset);
+        for (const auto &section : sections_) {
+            for (const uint64_t hash : section.hashes) {
+                store(out, hash);
+            }
+            for (const uint64_t word : section.bits) {
+                store(out, word);
+            }
+        }
+        const auto file_size = static_cast<uint64_t>(out.size());
+        std::vector<unsigned char> size_bytes;
+        store(size_bytes, file_size);
+        std::memcpy(out.data() + file_size_at, size_bytes.data(), size_bytes.size());
+
+        const std::string temporary = path + ".tmp";
+        std::error_code error;
+#ifdef _WIN32
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size()))) {
+                return false;
+            }
+        }
+#else
+        const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool written = true;
+        for (size_t done = 0; written && done < out.size();) {
+            const ssize_t n = ::write(fd, out.data() + done, out.size() - done);
+            written = n > 0;
+            done += written ? static_cast<size_t>(n) : 0;
+        }
+        written = written && fsync(fd) == 0;
+        close(fd);
+        if (!written) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+#endif
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+#ifndef _WIN32
+        // make the rename itself durable
+        const auto directory = std::filesystem::path(path).parent_path();
+        if (const int dir = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            dir >= 0) {
+            fsync(dir);
+            close(dir);
+        }
+#endif
+        return true;
+    }
+
+    uint64_t SnapshotReader::StoredSection::hash_at(const size_t position) const {
+        return load_u64(hashes_ + position * sizeof(uint64_t));
+    }
+
+    bool SnapshotReader::StoredSection::bit_at(const size_t position) const {
+        return (load_u64(bits_ + position / 64 * sizeof(uint64_t)) >> (position % 64)) & 1;
+    }
+
+    void SnapshotReader::StoredSection::build_table() {
+        table_.assign(std::bit_ceil(size_t{count_} * 2 + 1), 0);
+        const size_t mask = table_.size() - 1;
+        for (uint32_t position = 0; position < count_; ++position) {
+            size_t slot = hash_at(position) & mask;
+            while (table_[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            table_[slot] = position + 1;
+        }
+    }
+
+    std::optional<bool> SnapshotReader::StoredSection::lookup(const size_t index, const uint64_t hash) {
+        if (index < count_ && hash_at(index) == hash) {
+            return bit_at(index);
+        }
+        if (table_.empty()) {
+            build_table();
+        }
+        const size_t mask = table_.size() - 1;
+        for (size_t slot = hash & mask; table_[slot] != 0; slot = (slot + 1) & mask) {
+            if (const uint32_t position = table_[slot] - 1; hash_at(position) == hash) {
+                return bit_at(position);
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::unique_ptr<SnapshotReader> SnapshotReader::open(const std::string &path) {
+        std::unique_ptr<SnapshotReader> reader(new SnapshotReader());
+
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return nullptr;
+        }
+        reader->buffer_.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char *>(reader->buffer_.data()),
+                       static_cast<std::streamsize>(reader->buffer_.size()))) {
+            return nullptr;
+        }
+        reader->data_ = reader->buffer_.data();
+        reader->length_ = reader->buffer_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < header_size) {
+            close(fd);
+            return nullptr;
+        }
+
+        void *mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping keeps the file alive
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            return nullptr;
+        }
+        // apply() reads every array front to back
+        madvise(mapping, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        reader->data_ = static_cast<const unsigned char *>(mapping);
+        reader->length_ = static_cast<size_t>(st.st_size);
+#endif
+
+        if (!reader->validate()) {
+            return nullptr;
+        }
+        reader->section_count_ = load_u32(reader->data_ + 12);
+        return reader;
+    }
+
+    SnapshotReader::~SnapshotReader() {
+#ifndef _WIN32
+        if (data_) {
+            munmap(const_cast<unsigned char *>(data_), length_);
+        }
+#endif
+    }
+
+    bool SnapshotReader::validate() const {
+        if (length_ < header_size || std::memcmp(data_, magic, sizeof(magic)) != 0 || load_u32(data_ + 8) != version ||
+            load_u64(data_ + 16) != length_) {
+            return false;
+        }
+
+        const size_t sections = load_u32(data_ + 12);
+        if (sections > (length_ - header_size) / record_size) {
+            return false;
+        }
+        for (size_t i = 0; i < sections; ++i) {
+            const unsigned char *record = data_ + header_size + i * record_size;
+            const uint64_t hashes_offset = load_u64(record + 8);
+            const uint64_t bits_offset = load_u64(record + 16);
+            const uint64_t count = load_u32(record + 24);
+            const uint64_t words = (count + 63) / 64;
+            if (hashes_offset % 8 != 0 || bits_offset % 8 != 0 || hashes_offset > length_ ||
+                bits_offset > length_ || count > (length_ - hashes_offset) / 8 || words > (length_ - bits_offset) / 8) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    SnapshotReader::StoredSection SnapshotReader::section(const size_t i) const {
+        const unsigned char *record = data_ + header_size + i * record_size;
+        StoredSection section;
+        section.section_hash_ = load_u64(record);
+        section.hashes_ = data_ + load_u64(record + 8);
+        section.bits_ = data_ + load_u64(record + 16);
+        section.count_ = load_u32(record + 24);
+        section.selected_ = load_u32(record + 28);
+        return section;
+    }
+
+    std::optional<SnapshotReader::StoredSection> SnapshotReader::find(const std::string_view section_name) const {
+        const uint64_t hash = snapshot_hash(section_name);
+        for (size_t i = 0; i < section_count_; ++i) {
+            if (load_u64(data_ + header_size + i * record_size) == hash) {
+                return section(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+} // namespace tui
@@ -1,9 +1,14 @@
 #include "terminal_utils.hpp"
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#else
+#include <cstdio>
+#include <io.h>
 #endif
 
+#include <optional>
 #include <unistd.h>
 
 namespace tui {
@@ -17,6 +22,9 @@ namespace tui {
 #else
     termios TerminalUtils::original_termios = {};
     bool TerminalUtils::termios_saved = false;
+    int TerminalUtils::requested_input_fd = -1;
+    int TerminalUtils::input_fd = STDIN_FILENO;
+    bool TerminalUtils::input_fd_owned = false;
 #endif
 
     void TerminalUtils::init_terminal() {
@@ -323,7 +331,9 @@ namespace tui {
 #ifdef _WIN32
         return _getch();
 #else
-        return getchar();
+        // unbuffered, so select() in key_available() sees everything that is pending
+        unsigned char ch;
+        return read(input_fd, &ch, 1) == 1 ? ch : EOF;
 #endif
     }
 
@@ -335,12 +345,12 @@ namespace tui {
         timeval timeout{};
 
         FD_ZERO(&readfds);
-        FD_SET(STDIN_FILENO, &readfds);
+        FD_SET(input_fd, &readfds);
 
         timeout.tv_sec = 0;
         timeout.tv_usec = 0;
 
-        const int result = select(STDIN_FILENO + 1, &readfds, nullptr, nullptr, &timeout);
+        const int result = select(input_fd + 1, &readfds, nullptr, nullptr, &timeout);
         return result > 0;
 #endif
     }
@@ -615,7 +625,7 @@ namespace tui {
         if (termios_saved) {
             struct termios new_termios = original_termios;
             new_termios.c_lflag = enable ? new_termios.c_lflag | ECHO : new_termios.c_lflag & ~ECHO;
-            tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
+            tcsetattr(input_fd, TCSANOW, &new_termios);
         }
 #endif
     }
@@ -632,13 +642,47 @@ namespace tui {
         if (termios_saved) {
             struct termios new_termios = original_termios;
             new_termios.c_lflag = enable ? new_termios.c_lflag | ICANON : new_termios.c_lflag & ~ICANON;
-            tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
+            tcsetattr(input_fd, TCSANOW, &new_termios);
         }
 #endif
     }
 
     void TerminalUtils::flush() { std::cout.flush(); }
 
+    void TerminalUtils::set_input_fd([[maybe_unused]] const int fd) {
+#ifndef _WIN32
+        requested_input_fd = fd;
+#endif
+    }
+
+    bool TerminalUtils::has_terminal() {
+#ifdef _WIN32
+        return _isatty(_fileno(stdout)) && _isatty(_fileno(stdin));
+#else
+        if (!isatty(STDOUT_FILENO)) {
+            return false;
+        }
+        if (requested_input_fd >= 0 || isatty(STDIN_FILENO)) {
+            return true;
+        }
+        // the same fallback init_platform_terminal() uses
+        const int tty = open("/dev/tty", O_RDONLY | O_CLOEXEC);
+        if (tty < 0) {
+            return false;
+        }
+        close(tty);
+        return true;
+#endif
+    }
+
+    int TerminalUtils::get_input_fd() {
+#ifdef _WIN32
+        return 0;
+#else
+        return input_fd;
+#endif
+    }
+
     int TerminalUtils::get_centered_col(int content_width) {
         auto [height, width] = get_terminal_size();
         return std::max(1, (width - content_width) / 2 + 1);
@@ -695,14 +739,24 @@ namespace tui {
 
         hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 #else
-        if (tcgetattr(STDIN_FILENO, &original_termios) == 0) {
+        if (requested_input_fd >= 0) {
+            input_fd = requested_input_fd;
+        } else if (!isatty(STDIN_FILENO)) {
+            // stdin carries data, keystrokes come from the controlling terminal
+            if (const int tty = open("/dev/tty", O_RDONLY | O_CLOEXEC); tty >= 0) {
+                input_fd = tty;
+                input_fd_owned = true;
+            }
+        }
+
+        if (tcgetattr(input_fd, &original_termios) == 0) {
             termios_saved = true;
             struct termios new_termios = original_termios;
             new_termios.c_lflag &= ~(ICANON | ECHO);
             new_termios.c_iflag &= ~ICRNL;
             new_termios.c_cc[VMIN] = 1;
             new_termios.c_cc[VTIME] = 0;
-            tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
+            tcsetattr(input_fd, TCSANOW, &new_termios);
         }
 #endif
     }
@@ -717,9 +771,14 @@ namespace tui {
         }
 #else
         if (termios_saved) {
-            tcsetattr(STDIN_FILENO, TCSANOW, &original_termios);
+            tcsetattr(input_fd, TCSANOW, &original_termios);
             termios_saved = false;
         }
+        if (input_fd_owned) {
+            close(input_fd);
+            input_fd_owned = false;
+        }
+        input_fd = STDIN_FILENO;
 #endif
     }
 
@@ -755,6 +814,9 @@ namespace tui {
         case TerminalUtils::Key::ESCAPE:
             converted_key = TerminalUtils::Key::ESCAPE;
             break;
+        case TerminalUtils::Key::BACKSPACE:
+            converted_key = TerminalUtils::Key::BACKSPACE;
+            break;
         default:
             if (character >= 'a' && character <= 'z') {
                 switch (character) {
@@ -0,0 +1,115 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace tui {
+    namespace {
+        thread_local bool inside_loop = false;
+    }
+
+    struct ThreadPool::Job {
+        Job(const RangeFn &range_fn, const size_t total, const size_t chunk) :
+            fn(&range_fn), count(total), grain(chunk) {}
+
+        const RangeFn *fn;
+        size_t count;
+        size_t grain;
+        std::atomic<size_t> next{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        void run() {
+            inside_loop = true;
+            for (size_t begin = next.fetch_add(grain); begin < count; begin = next.fetch_add(grain)) {
+                try {
+                    (*fn)(begin, std::min(begin + grain, count));
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    next.store(count);
+                }
+            }
+            inside_loop = false;
+        }
+    };
+
+    ThreadPool::ThreadPool(const size_t threads) {
+        for (size_t i = 1; i < threads; ++i) {
+            workers_.emplace_back([this](const std::stop_token &stop) { work(stop); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        for (auto &worker : workers_) {
+            worker.request_stop();
+        }
+        wake_.notify_all();
+    }
+
+    ThreadPool &ThreadPool::shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::parallel_for(const size_t count, size_t grain, const RangeFn &fn) {
+        grain = std::max<size_t>(grain, 1);
+        if (count == 0) {
+            return;
+        }
+        if (workers_.empty() || count <= grain || inside_loop) {
+            fn(0, count);
+            return;
+        }
+
+        std::lock_guard run(run_mutex_);
+        Job job(fn, count, grain);
+        {
+            std::lock_guard lock(mutex_);
+            job_ = &job;
+            busy_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        job.run();
+
+        {
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [this] { return busy_ == 0; });
+            job_ = nullptr;
+        }
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+    void ThreadPool::work(const std::stop_token &stop) {
+        uint64_t seen = 0;
+        while (true) {
+            Job *job;
+            {
+                std::unique_lock lock(mutex_);
+                if (!wake_.wait(lock, stop, [&] { return generation_ != seen; })) {
+                    return;
+                }
+                seen = generation_;
+                job = job_;
+            }
+
+            job->run();
+
+            bool last;
+            {
+                std::lock_guard lock(mutex_);
+                last = --busy_ == 0;
+            }
+            if (last) {
+                done_.notify_one();
+            }
+        }
+    }
+} // namespace tui
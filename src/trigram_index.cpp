@@ -0,0 +1,182 @@
+#include "trigram_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <ranges>
+
+namespace tui {
+    namespace {
+        /**
+         * @brief Rows of a name snapshot taken on the UI thread
+         */
+        class NameList final : public ItemSource {
+        public:
+            explicit NameList(std::vector<std::string> names) : names_(std::move(names)) {}
+
+            [[nodiscard]] size_t size() const override { return names_.size(); }
+            [[nodiscard]] std::string_view name(const size_t index) const override { return names_[index]; }
+            [[nodiscard]] std::string_view description(size_t) const override { return {}; }
+            [[nodiscard]] bool concurrent_reads() const override { return true; }
+
+        private:
+            std::vector<std::string> names_;
+        };
+
+        uint32_t fold(const char c) { return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c))); }
+
+        /**
+         * @brief Call fn with every trigram of text, lower-cased and packed into the low 24 bits
+         */
+        template <typename Fn>
+        void for_each_trigram(const std::string_view text, Fn &&fn) {
+            if (text.size() < TrigramIndex::min_query_length) {
+                return;
+            }
+            uint32_t trigram = fold(text[0]) << 8 | fold(text[1]);
+            for (size_t i = 2; i < text.size(); ++i) {
+                trigram = (trigram << 8 | fold(text[i])) & 0xFFFFFF;
+                fn(trigram);
+            }
+        }
+    } // namespace
+
+    void TrigramIndex::update(const SectionHandle section, const uint64_t revision,
+                              std::shared_ptr<const ItemSource> names) {
+        if (!names->concurrent_reads()) {
+            // the worker would race the caller for the source's rows; copy what is ready instead
+            std::vector<std::string> copied(names->size());
+            for (size_t index = 0; index < copied.size(); ++index) {
+                if (names->is_ready(index)) {
+                    copied[index] = names->name(index);
+                }
+            }
+            names = std::make_shared<const NameList>(std::move(copied));
+        }
+        {
+            std::lock_guard lock(mutex_);
+            const auto it = std::ranges::find(queued_, section, &std::pair<SectionHandle, uint64_t>::first);
+            if (it != queued_.end()) {
+                it->second = revision;
+            } else {
+                queued_.emplace_back(section, revision);
+            }
+        }
+        worker_.post([this, section, revision, names = std::move(names)] { build(section, revision, names); });
+    }
+
+    void TrigramIndex::update(const SectionHandle section, const uint64_t revision, std::vector<std::string> names) {
+        update(section, revision, std::make_shared<const NameList>(std::move(names)));
+    }
+
+    void TrigramIndex::remove(const SectionHandle section) {
+        std::lock_guard lock(mutex_);
+        std::erase_if(queued_, [&](const auto &entry) { return entry.first == section; });
+        std::erase_if(segments_, [&](const auto &entry) { return entry.first == section; });
+    }
+
+    void TrigramIndex::clear() {
+        worker_.clear();
+        std::lock_guard lock(mutex_);
+        queued_.clear();
+        segments_.clear();
+    }
+
+    std::optional<uint64_t> TrigramIndex::queued_revision(const SectionHandle section) const {
+        std::lock_guard lock(mutex_);
+        const auto it = std::ranges::find(queued_, section, &std::pair<SectionHandle, uint64_t>::first);
+        return it != queued_.end() ? std::optional(it->second) : std::nullopt;
+    }
+
+    void TrigramIndex::build(const SectionHandle section, const uint64_t revision,
+                             const std::shared_ptr<const ItemSource> &names) {
+        if (queued_revision(section) != revision) {
+            return; // superseded by a newer update, or removed
+        }
+
+        building_ = true;
+        auto postings = std::make_shared<Postings>();
+        for (size_t index = 0; index < names->size(); ++index) {
+            if (!names->is_ready(index)) {
+                continue; // never make a slow source fetch everything just to index it
+            }
+            const auto item = static_cast<uint32_t>(index);
+            for_each_trigram(names->name(index), [&](const uint32_t trigram) {
+                auto &list = (*postings)[trigram];
+                if (list.empty() || list.back() != item) {
+                    list.push_back(item);
+                }
+            });
+        }
+        for (auto &list : *postings | std::views::values) {
+            list.shrink_to_fit();
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            const auto queued = std::ranges::find(queued_, section, &std::pair<SectionHandle, uint64_t>::first);
+            if (queued != queued_.end() && queued->second == revision) {
+                const auto it = std::ranges::find(segments_, section, &decltype(segments_)::value_type::first);
+                if (it != segments_.end()) {
+                    it->second = std::move(postings);
+                } else {
+                    segments_.emplace_back(section, std::move(postings));
+                }
+            }
+        }
+        building_ = false;
+    }
+
+    std::vector<TrigramIndex::Hit> TrigramIndex::candidates(const std::string_view query, const size_t limit) const {
+        std::vector<uint32_t> trigrams;
+        for_each_trigram(query, [&](const uint32_t trigram) { trigrams.push_back(trigram); });
+        std::ranges::sort(trigrams);
+        trigrams.erase(std::ranges::unique(trigrams).begin(), trigrams.end());
+
+        std::vector<Hit> hits;
+        if (trigrams.empty()) {
+            return hits;
+        }
+
+        // copy the segment pointers so a build finishing meanwhile doesn't block on us
+        std::vector<std::pair<SectionHandle, std::shared_ptr<const Postings>>> segments;
+        {
+            std::lock_guard lock(mutex_);
+            segments = segments_;
+        }
+
+        std::vector<const std::vector<uint32_t> *> lists;
+        std::vector<uint32_t> matches;
+        std::vector<uint32_t> scratch;
+        for (const auto &[section, postings] : segments) {
+            lists.clear();
+            for (const uint32_t trigram : trigrams) {
+                const auto it = postings->find(trigram);
+                if (it == postings->end()) {
+                    break;
+                }
+                lists.push_back(&it->second);
+            }
+            if (lists.size() != trigrams.size()) {
+                continue;
+            }
+
+            // intersect starting from the rarest trigram, so the working set only shrinks
+            std::ranges::sort(lists, {}, [](const auto *list) { return list->size(); });
+            matches = *lists.front();
+            for (size_t i = 1; i < lists.size() && !matches.empty(); ++i) {
+                scratch.clear();
+                std::ranges::set_intersection(matches, *lists[i], std::back_inserter(scratch));
+                matches.swap(scratch);
+            }
+
+            for (const uint32_t item : matches) {
+                if (hits.size() >= limit) {
+                    return hits;
+                }
+                hits.push_back({section, item});
+            }
+        }
+        return hits;
+    }
+} // namespace tui